@@ -0,0 +1,428 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+/*
+ * Usage: ./gen_instance [ -s seed ] [ -z zone_size ] [ -w ] [ -c ] dimension
+ *
+ * The gen_instance program writes a synthetic Amazon-like instance in the
+ * .ctsptw format read by LKH to standard output. The instance has the
+ * given dimension (the depot plus dimension - 1 stops) and is completely
+ * determined by dimension, seed (default 1), zone_size and the -w flag.
+ * The program uses its own random number generator and no floating-point
+ * library functions other than sqrt, so the same instance is produced on
+ * any machine.
+ *
+ * The stops are grouped into zones of about zone_size (default 8) stops.
+ * About four zones make up a super zone, and about three super zones make
+ * up a super super zone. The zones, super zones and super super zones are
+ * given as GTSP sets at three levels (GTSP_SET_SECTION,
+ * SUPER_GTSP_SET_SECTION and SUPER_SUPER_GTSP_SET_SECTION). The depot
+ * forms a set of its own at each level (set number 1).
+ *
+ * The geography is nested as well: each super super zone has a random
+ * center, and the centers of its super zones, their zones, and the stops
+ * of the zones are scattered around the enclosing center. The depot lies
+ * 5-15 km away from the stops. The travel times (in seconds) are the
+ * Euclidean distances divided by a speed, multiplied by a random factor
+ * between 1 and 1.3 chosen independently for each direction, so the
+ * instance is asymmetric.
+ *
+ * A hidden route is constructed by visiting the super super zones, super
+ * zones, zones and stops in nearest neighbor order, starting at the
+ * depot. All precedence, path and neighbor constraints are sampled from
+ * this route, so the constraints are never contradictory. A few
+ * precedence constraints are followed by an alternative ('|') that may
+ * be violated by the hidden route.
+ *
+ * If -w is given, each stop is given a service time, and about one fifth
+ * of the stops are given a time window that contains the arrival time of
+ * the hidden route.
+ *
+ * If -c is given, the coordinates of the nodes are written in a
+ * NODE_COORD_SECTION as latitudes and longitudes (in degrees) of a map
+ * placed near Seattle (used by LKH with SPARSE_NEIGHBORS).
+ */
+
+typedef struct Point {
+    double X, Y;
+} Point;
+
+static unsigned long long State;
+
+static double Uniform(void);
+static int RandomInt(int n);
+static double Normal(void);
+static double Dist(Point *A, Point *B);
+static int PickNearest(int *Item, int Count, Point * Center, Point * From);
+static void Scatter(Point * P, Point * Center, double Radius);
+static void PrintPrecedences(char *Section, int Count, int Constraints,
+                             int *Rank);
+
+int main(int argc, char *argv[])
+{
+    int Dimension, Stops, Zones, Supers, SuperSupers, ZoneSize = 8;
+    int TimeWindows = 0, Coordinates = 0, c, i, j, k, s, z, Pos, Done, Zoned;
+    unsigned long Seed = 1;
+    int *ZoneOf, *SuperOf, *SuperSuperOf, *Id, *Index, *Route;
+    int *ZoneRank, *SuperRank, *SuperSuperRank, *ZoneAt;
+    int *SSLeft, *SLeft, *ZLeft, *PLeft, nSS, nS, nZ, nP;
+    int *Service, *Earliest, *Latest;
+    double L, Spread, D;
+    Point *P, *ZoneCenter, *SuperCenter, *SuperSuperCenter, Depot, Current;
+    int **T;
+
+    while ((c = getopt(argc, argv, "s:z:wc")) != -1) {
+        switch (c) {
+        case 's':
+            Seed = strtoul(optarg, 0, 10);
+            break;
+        case 'z':
+            ZoneSize = atoi(optarg);
+            break;
+        case 'w':
+            TimeWindows = 1;
+            break;
+        case 'c':
+            Coordinates = 1;
+            break;
+        default:
+            optind = argc;
+        }
+    }
+    if (argc - optind != 1 || ZoneSize < 1 ||
+        (Dimension = atoi(argv[optind])) < 3) {
+        fprintf(stderr, "./gen_instance [ -s seed ] [ -z zone_size ] "
+                "[ -w ] [ -c ] dimension\n");
+        return EXIT_FAILURE;
+    }
+    State = 0x9E3779B97F4A7C15ULL * (Seed + 1);
+    Stops = Dimension - 1;
+    Zones = (Stops + ZoneSize / 2) / ZoneSize;
+    if (Zones < 2)
+        Zones = 2;
+    if (Zones > Stops)
+        Zones = Stops;
+    Supers = (Zones + 3) / 4;
+    SuperSupers = (Supers + 2) / 3;
+
+    ZoneOf = (int *) malloc(Stops * sizeof(int));
+    SuperOf = (int *) malloc(Zones * sizeof(int));
+    SuperSuperOf = (int *) malloc(Supers * sizeof(int));
+    ZoneRank = (int *) malloc(Zones * sizeof(int));
+    ZoneAt = (int *) malloc(Zones * sizeof(int));
+    SuperRank = (int *) malloc(Supers * sizeof(int));
+    SuperSuperRank = (int *) malloc(SuperSupers * sizeof(int));
+    SSLeft = (int *) malloc(SuperSupers * sizeof(int));
+    SLeft = (int *) malloc(Supers * sizeof(int));
+    ZLeft = (int *) malloc(Zones * sizeof(int));
+    PLeft = (int *) malloc(Stops * sizeof(int));
+    Id = (int *) malloc(Stops * sizeof(int));
+    Index = (int *) malloc(Dimension * sizeof(int));
+    Route = (int *) malloc(Stops * sizeof(int));
+    Service = (int *) calloc(Dimension, sizeof(int));
+    Earliest = (int *) calloc(Dimension, sizeof(int));
+    Latest = (int *) malloc(Dimension * sizeof(int));
+    P = (Point *) malloc(Stops * sizeof(Point));
+    ZoneCenter = (Point *) malloc(Zones * sizeof(Point));
+    SuperCenter = (Point *) malloc(Supers * sizeof(Point));
+    SuperSuperCenter = (Point *) malloc(SuperSupers * sizeof(Point));
+    T = (int **) malloc(Dimension * sizeof(int *));
+    for (i = 0; i < Dimension; i++)
+        T[i] = (int *) malloc(Dimension * sizeof(int));
+
+    /* Nested partition: consecutive blocks of zones and super zones */
+    for (z = 0; z < Zones; z++)
+        SuperOf[z] = (int) ((long long) z * Supers / Zones);
+    for (s = 0; s < Supers; s++)
+        SuperSuperOf[s] = (int) ((long long) s * SuperSupers / Supers);
+    for (k = 0; k < Stops; k++)
+        ZoneOf[k] = k < Zones ? k : RandomInt(Zones);
+
+    /* Nested geography (in meters) */
+    L = 300 * sqrt((double) Stops);
+    Spread = 0.25 * L;
+    for (i = 0; i < SuperSupers; i++) {
+        SuperSuperCenter[i].X = L * Uniform();
+        SuperSuperCenter[i].Y = L * Uniform();
+    }
+    for (s = 0; s < Supers; s++)
+        Scatter(&SuperCenter[s], &SuperSuperCenter[SuperSuperOf[s]],
+                Spread / sqrt((double) SuperSupers));
+    for (z = 0; z < Zones; z++)
+        Scatter(&ZoneCenter[z], &SuperCenter[SuperOf[z]],
+                Spread / sqrt((double) Supers));
+    for (k = 0; k < Stops; k++)
+        Scatter(&P[k], &ZoneCenter[ZoneOf[k]],
+                Spread / sqrt((double) Zones));
+    do {
+        Depot.X = 2 * Uniform() - 1;
+        Depot.Y = 2 * Uniform() - 1;
+    } while ((D = Depot.X * Depot.X + Depot.Y * Depot.Y) > 1 || D < 0.01);
+    D = (5000 + 10000 * Uniform()) / sqrt(D);
+    Depot.X = L / 2 + D * Depot.X;
+    Depot.Y = L / 2 + D * Depot.Y;
+
+    /*
+     * Node numbers: 1 is the depot, stop k has number Id[k] + 2.
+     * Node number i + 1 has index Index[i] in T (0 is the depot).
+     */
+    for (k = 0; k < Stops; k++)
+        Id[k] = k;
+    for (k = Stops - 1; k > 0; k--) {
+        j = RandomInt(k + 1);
+        i = Id[k];
+        Id[k] = Id[j];
+        Id[j] = i;
+    }
+    Index[0] = 0;
+    for (k = 0; k < Stops; k++)
+        Index[Id[k] + 1] = k + 1;
+
+    /* Asymmetric travel times (in seconds). Index 0 is the depot */
+    for (i = 0; i < Dimension; i++) {
+        for (j = 0; j < Dimension; j++) {
+            Point *A, *B;
+            if (i == j) {
+                T[i][j] = 0;
+                continue;
+            }
+            A = i == 0 ? &Depot : &P[i - 1];
+            B = j == 0 ? &Depot : &P[j - 1];
+            T[i][j] = (int) (Dist(A, B) * (1 + 0.3 * Uniform()) /
+                             (i == 0 || j == 0 ? 15.0 : 8.0) + 0.5);
+        }
+    }
+
+    /* The hidden route */
+    Pos = Done = Zoned = 0;
+    Current = Depot;
+    for (nSS = 0; nSS < SuperSupers; nSS++)
+        SSLeft[nSS] = nSS;
+    for (i = 0; nSS > 0; i++) {
+        k = PickNearest(SSLeft, nSS, SuperSuperCenter, &Current);
+        SuperSuperRank[SSLeft[k]] = i;
+        for (nS = 0, s = 0; s < Supers; s++)
+            if (SuperSuperOf[s] == SSLeft[k])
+                SLeft[nS++] = s;
+        SSLeft[k] = SSLeft[--nSS];
+        while (nS > 0) {
+            k = PickNearest(SLeft, nS, SuperCenter, &Current);
+            SuperRank[SLeft[k]] = Done++;
+            for (nZ = 0, z = 0; z < Zones; z++)
+                if (SuperOf[z] == SLeft[k])
+                    ZLeft[nZ++] = z;
+            SLeft[k] = SLeft[--nS];
+            while (nZ > 0) {
+                k = PickNearest(ZLeft, nZ, ZoneCenter, &Current);
+                z = ZLeft[k];
+                ZLeft[k] = ZLeft[--nZ];
+                ZoneAt[Zoned] = z;
+                ZoneRank[z] = Zoned++;
+                for (nP = 0, j = 0; j < Stops; j++)
+                    if (ZoneOf[j] == z)
+                        PLeft[nP++] = j;
+                while (nP > 0) {
+                    k = PickNearest(PLeft, nP, P, &Current);
+                    Route[Pos++] = PLeft[k];
+                    Current = P[PLeft[k]];
+                    PLeft[k] = PLeft[--nP];
+                }
+            }
+        }
+    }
+
+    /* Service times and time windows consistent with the hidden route */
+    for (i = 0; i < Dimension; i++)
+        Latest[i] = 1000000;
+    if (TimeWindows) {
+        int Time = 0, From = 0, To;
+        for (k = 0; k < Stops; k++) {
+            To = Route[k] + 1;
+            Time += T[From][To];
+            Service[To] = 30 + RandomInt(151);
+            if (Uniform() < 0.2) {
+                Earliest[To] = Time - RandomInt(1801);
+                if (Earliest[To] < 0)
+                    Earliest[To] = 0;
+                Latest[To] = Time + 900 + RandomInt(2701);
+            }
+            Time += Service[To];
+            From = To;
+        }
+    }
+
+    printf("NAME : gen%d_%lu%s\n", Dimension, Seed, TimeWindows ? "w" : "");
+    printf("COMMENT : gen_instance -s %lu -z %d%s %d\n",
+           Seed, ZoneSize, TimeWindows ? " -w" : "", Dimension);
+    printf("TYPE : TSPTW\n");
+    printf("DIMENSION : %d\n", Dimension);
+    printf("EDGE_WEIGHT_TYPE : EXPLICIT\n");
+    printf("EDGE_WEIGHT_FORMAT : FULL_MATRIX\n");
+    printf("EDGE_WEIGHT_SECTION\n");
+    for (i = 0; i < Dimension; i++) {
+        for (j = 0; j < Dimension; j++)
+            printf(j ? " %d" : "%d", T[Index[i]][Index[j]]);
+        printf("\n");
+    }
+    if (Coordinates) {
+        /* 111195 meters per degree of latitude; cos(47.6) = 0.674302 */
+        printf("NODE_COORD_SECTION\n");
+        for (i = 0; i < Dimension; i++) {
+            Point *A = Index[i] == 0 ? &Depot : &P[Index[i] - 1];
+            printf("%d %0.6f %0.6f\n", i + 1, 47.6 + A->Y / 111195,
+                   -122.3 + A->X / (111195 * 0.674302));
+        }
+    }
+    printf("DEPOT_SECTION\n1\n-1\n");
+    printf("GTSP_SETS : %d\n", Zones + 1);
+    printf("GTSP_SET_SECTION\n1 1 -1\n");
+    for (z = 0; z < Zones; z++) {
+        printf("%d", z + 2);
+        for (k = 0; k < Stops; k++)
+            if (ZoneOf[k] == z)
+                printf(" %d", Id[k] + 2);
+        printf(" -1\n");
+    }
+    printf("SUPER_GTSP_SETS : %d\n", Supers + 1);
+    printf("SUPER_GTSP_SET_SECTION\n1 1 -1\n");
+    for (s = 0; s < Supers; s++) {
+        printf("%d", s + 2);
+        for (z = 0; z < Zones; z++)
+            if (SuperOf[z] == s)
+                printf(" %d", z + 2);
+        printf(" -1\n");
+    }
+    printf("SUPER_SUPER_GTSP_SETS : %d\n", SuperSupers + 1);
+    printf("SUPER_SUPER_GTSP_SET_SECTION\n1 1 -1\n");
+    for (i = 0; i < SuperSupers; i++) {
+        printf("%d", i + 2);
+        for (s = 0; s < Supers; s++)
+            if (SuperSuperOf[s] == i)
+                printf(" %d", s + 2);
+        printf(" -1\n");
+    }
+    PrintPrecedences("ZONE_PRECEDENCE_SECTION", Zones, Zones / 2, ZoneRank);
+    printf("ZONE_PATH_SECTION\n");
+    for (k = Zones / 8; k > 0; k--) {
+        i = RandomInt(Zones - 1);
+        printf("%d %d\n", ZoneAt[i] + 2, ZoneAt[i + 1] + 2);
+    }
+    printf("-1\n");
+    printf("ZONE_NEIGHBOR_SECTION\n");
+    for (k = Zones / 4; k > 0; k--) {
+        i = RandomInt(Zones - 1);
+        if (RandomInt(2))
+            printf("%d %d\n", ZoneAt[i] + 2, ZoneAt[i + 1] + 2);
+        else
+            printf("%d %d\n", ZoneAt[i + 1] + 2, ZoneAt[i] + 2);
+    }
+    printf("-1\n");
+    PrintPrecedences("SUPER_ZONE_PRECEDENCE_SECTION", Supers, Supers / 3,
+                     SuperRank);
+    PrintPrecedences("SUPER_SUPER_ZONE_PRECEDENCE_SECTION", SuperSupers,
+                     SuperSupers / 2, SuperSuperRank);
+    if (TimeWindows) {
+        printf("TIME_WINDOW_SECTION\n");
+        for (i = 0; i < Dimension; i++)
+            printf("%d %d %d\n", i + 1, Earliest[Index[i]],
+                   Latest[Index[i]]);
+        printf("SERVICE_TIME_SECTION\n");
+        for (i = 0; i < Dimension; i++)
+            printf("%d %d\n", i + 1, Service[Index[i]]);
+    }
+    printf("EOF\n");
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Uniform returns a pseudo-random number in [0,1) (xorshift64*).
+ */
+
+static double Uniform()
+{
+    State ^= State >> 12;
+    State ^= State << 25;
+    State ^= State >> 27;
+    return ((State * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int RandomInt(int n)
+{
+    return (int) (Uniform() * n);
+}
+
+/*
+ * Normal returns an approximately standard normally distributed number
+ * (sum of four uniform numbers).
+ */
+
+static double Normal()
+{
+    return (Uniform() + Uniform() + Uniform() + Uniform() - 2) * sqrt(3.0);
+}
+
+static double Dist(Point * A, Point * B)
+{
+    double dx = A->X - B->X, dy = A->Y - B->Y;
+    return sqrt(dx * dx + dy * dy);
+}
+
+static void Scatter(Point * P, Point * Center, double Radius)
+{
+    P->X = Center->X + Radius * Normal();
+    P->Y = Center->Y + Radius * Normal();
+}
+
+/*
+ * PickNearest returns the index in Item of the item whose center is
+ * nearest to From.
+ */
+
+static int PickNearest(int *Item, int Count, Point * Center, Point * From)
+{
+    int i, Best = 0;
+    double d, BestD = Dist(&Center[Item[0]], From);
+
+    for (i = 1; i < Count; i++)
+        if ((d = Dist(&Center[Item[i]], From)) < BestD) {
+            BestD = d;
+            Best = i;
+        }
+    return Best;
+}
+
+/*
+ * PrintPrecedences prints a constraint section with Constraints random
+ * precedence constraints between Count sets (numbered from 2) that are
+ * satisfied by the order given by Rank. One in ten constraints is
+ * followed by a random alternative.
+ */
+
+static void PrintPrecedences(char *Section, int Count, int Constraints,
+                             int *Rank)
+{
+    int a, b, t;
+
+    printf("%s\n", Section);
+    if (Count >= 2) {
+        while (Constraints-- > 0) {
+            a = RandomInt(Count);
+            while ((b = RandomInt(Count)) == a);
+            if (Rank[a] > Rank[b]) {
+                t = a;
+                a = b;
+                b = t;
+            }
+            printf("%d %d\n", a + 2, b + 2);
+            if (Uniform() < 0.1) {
+                a = RandomInt(Count);
+                while ((b = RandomInt(Count)) == a);
+                printf("|\n%d %d\n", a + 2, b + 2);
+            }
+        }
+    }
+    printf("-1\n");
+}
@@ -0,0 +1,406 @@
+#include "Segment.h"
+#include "LKH.h"
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Usage: ./microbench [ -t seconds ] instance
+ *
+ * The microbench program measures the time per call (ns/op) and the
+ * number of time-stamp counter cycles per call (cycles/op) of the hot
+ * kernels of LKH on the given instance:
+ *
+ *     Minimum1TreeCost    (sparse and dense)
+ *     GenerateCandidates
+ *     Penalty             (zone constraints only, and with time windows)
+ *     Between
+ *     Swap3 + RestoreTour (a 3-opt move made by three calls of Flip,
+ *                          and undone)
+ *     Swap3 + FlipUpdate  (a 3-opt move made and kept)
+ *     SpecialMove         (on a fixed, locally optimal tour)
+ *     MergeWithTour       (of two locally optimal tours)
+ *     MergeWithTourGPX    (of the same two tours)
+ *
+ * The instance is preprocessed as by LKH (CTSP transform, ascent and
+ * candidate generation). The tour kernels are run on the tour found by
+ * FindTour with 20 trials, and MergeWithTour and MergeWithTourGPX merge
+ * it with a second such tour. Each kernel is called repeatedly for at
+ * least the given number of seconds (default 0.5). Time spent in setting
+ * up the calls (choosing random moves, restoring the tours, freeing
+ * candidate sets) is not included.
+ *
+ * The cycle counts are time-stamp counter (rdtsc) cycles, which run at
+ * a constant rate that may differ from the actual core clock rate. They
+ * are not available on other architectures than x86.
+ */
+
+typedef struct Measure {
+    double Time, StartTime;
+    unsigned long long Cycles, StartCycles;
+    long long Ops;
+} Measure;
+
+static double MinTime = 0.5;
+
+static double Clock(void);
+static unsigned long long CycleCount(void);
+static void Reset(Measure * M);
+static void Begin(Measure * M);
+static void End(Measure * M, long long Ops);
+static void Report(char *Kernel, Measure * M);
+static Node **SaveTour(void);
+static void SetTour(Node ** Order);
+static void AdjustC(int Sign);
+static void RandomMove(Node ** t);
+
+int main(int argc, char *argv[])
+{
+    char ParFileName[] = "/tmp/microbenchXXXXXX";
+    FILE *ParFile;
+    Node **TourA, **TourB, *N, *t1, *t2, *(*Move)[6];
+    Measure M;
+    long long MaxAlpha, Sum = 0, G0, Gain;
+    int Moves = 1024, Improved = 0, Batch, c, fd, i, j, X2;
+    volatile long long Sink;
+
+    while ((c = getopt(argc, argv, "t:")) != -1) {
+        switch (c) {
+        case 't':
+            MinTime = atof(optarg);
+            break;
+        default:
+            optind = argc;
+        }
+    }
+    if (argc - optind != 1) {
+        fprintf(stderr, "./microbench [ -t seconds ] instance\n");
+        return EXIT_FAILURE;
+    }
+    if ((fd = mkstemp(ParFileName)) < 0 ||
+        !(ParFile = fdopen(fd, "w"))) {
+        fprintf(stderr, "Cannot create parameter file\n");
+        return EXIT_FAILURE;
+    }
+    fprintf(ParFile, "PROBLEM_FILE = %s\n", argv[optind]);
+    fprintf(ParFile, "CTSP_TRANSFORM = YES\n");
+    fprintf(ParFile, "SEED = 1\n");
+    fprintf(ParFile, "TRACE_LEVEL = 0\n");
+    fclose(ParFile);
+    ParameterFileName = ParFileName;
+    ReadParameters();
+    unlink(ParFileName);
+    StartTime = GetTime();
+    Stats.StartTime = GetWallTime();
+    MaxMatrixDimension = 20000;
+    ReadProblem();
+    if (CTSPTransform && GTSPSets > 1) {
+        /* CTSP transform (as in LKHmain) */
+        Node *From, *To;
+        MM = INT_MAX / GTSPSets / Precision;
+        for (i = 1; i <= DimensionSaved; i++) {
+            From = &NodeSet[i];
+            for (j = 1; j <= DimensionSaved; j++) {
+                if (i == j)
+                    continue;
+                To = &NodeSet[j];
+                if (From->MyCluster != To->MyCluster)
+                    From->C[j] += MM;
+            }
+        }
+    }
+    AllocateStructures();
+    CreateCandidateSet();
+    InitializeStatistics();
+    printf("%s: Dimension = %d\n", Name, DimensionSaved);
+    printf("%-24s %12s %12s %12s\n", "Kernel", "ns/op", "cycles/op",
+           "ops");
+
+    /* 1-tree and candidate kernels (on the penalties of the ascent) */
+    AdjustC(-1);
+    Reset(&M);
+    do {
+        Begin(&M);
+        Sum += Minimum1TreeCost(1);
+        End(&M, 1);
+    } while (M.Time < MinTime);
+    Report("Minimum1TreeCost sparse", &M);
+    Reset(&M);
+    do {
+        Begin(&M);
+        Sum += Minimum1TreeCost(0);
+        End(&M, 1);
+    } while (M.Time < MinTime);
+    Report("Minimum1TreeCost dense", &M);
+    MaxAlpha = (long long) fabs(Excess * LowerBound * Precision);
+    Reset(&M);
+    do {
+        N = FirstNode;
+        do {
+            free(N->CandidateSet);
+            N->CandidateSet = 0;
+        } while ((N = N->Suc) != FirstNode);
+        Begin(&M);
+        GenerateCandidates(MaxCandidates, MaxAlpha, CandidateSetSymmetric);
+        End(&M, 1);
+    } while (M.Time < MinTime);
+    Report("GenerateCandidates", &M);
+    AdjustC(1);
+
+    /* Two locally optimal tours */
+    MaxTrials = 20;
+    FindTour();
+    TourA = SaveTour();
+    SRandom(2);
+    FindTour();
+    TourB = SaveTour();
+    SetTour(TourA);
+
+    Batch = 1 + 100000 / Dimension;
+    for (j = 0; j <= 1; j++) {
+        TimeWindowsUsed = j;
+        Reset(&M);
+        do {
+            Begin(&M);
+            for (i = 0; i < Batch; i++) {
+                CurrentPenalty = LLONG_MAX;
+                Sum += Penalty();
+            }
+            End(&M, Batch);
+        } while (M.Time < MinTime);
+        Report(j == 0 ? "Penalty zones" : "Penalty time windows", &M);
+    }
+    TimeWindowsUsed = 0;
+
+    Move = (Node *(*)[6]) malloc(Moves * sizeof(*Move));
+    for (i = 0; i < Moves; i++)
+        RandomMove(Move[i]);
+    Reset(&M);
+    do {
+        Begin(&M);
+        for (i = 0; i < Moves; i++)
+            Sum += Between(Move[i][1], Move[i][4], Move[i][2]);
+        End(&M, Moves);
+    } while (M.Time < MinTime);
+    Report("Between", &M);
+    Reset(&M);
+    do {
+        Begin(&M);
+        for (i = 0; i < Moves; i++) {
+            Node **t = Move[i];
+            Swaps = 0;
+            Swap3(t[0], t[1], t[3], t[5], t[4], t[3], t[5], t[1], t[2]);
+            RestoreTour();
+        }
+        End(&M, Moves);
+    } while (M.Time < MinTime);
+    Report("Swap3 + RestoreTour", &M);
+    Reset(&M);
+    do {
+        for (i = 0; i < Moves; i++) {
+            Node *t[6];
+            RandomMove(t);
+            Swaps = 0;
+            Begin(&M);
+            Swap3(t[0], t[1], t[3], t[5], t[4], t[3], t[5], t[1], t[2]);
+            FlipUpdate();
+            End(&M, 1);
+        }
+        SetTour(TourA);
+    } while (M.Time < MinTime);
+    Report("Swap3 + FlipUpdate", &M);
+
+    CurrentPenalty = LLONG_MAX;
+    CurrentPenalty = Penalty();
+    Reset(&M);
+    do {
+        Begin(&M);
+        for (i = 0; i < Dimension; i++) {
+            t1 = TourA[i];
+            for (X2 = 1; X2 <= 2; X2++) {
+                t2 = X2 == 1 ? PRED(t1) : SUC(t1);
+                if (Fixed(t1, t2))
+                    continue;
+                G0 = C(t1, t2);
+                Swaps = 0;
+                PenaltyGain = Gain = 0;
+                SpecialMove(t1, t2, &G0, &Gain);
+                M.Ops++;
+                if (PenaltyGain > 0 || Gain > 0) {
+                    CurrentPenalty -= PenaltyGain;
+                    StoreTour();
+                    Improved++;
+                    break;
+                }
+                RestoreTour();
+            }
+        }
+        End(&M, 0);
+    } while (M.Time < MinTime);
+    Report("SpecialMove", &M);
+    if (Improved > 0)
+        printf("  (%d improving SpecialMove calls)\n", Improved);
+
+    Reset(&M);
+    do {
+        SetTour(TourA);
+        for (i = 0; i < Dimension; i++)
+            TourB[i]->Next = TourB[(i + 1) % Dimension];
+        Begin(&M);
+        Sum += MergeWithTour();
+        End(&M, 1);
+    } while (M.Time < MinTime);
+    Report("MergeWithTour", &M);
+
+    Reset(&M);
+    do {
+        SetTour(TourA);
+        for (i = 0; i < Dimension; i++)
+            TourB[i]->Next = TourB[(i + 1) % Dimension];
+        Begin(&M);
+        Sum += MergeWithTourGPX();
+        End(&M, 1);
+    } while (M.Time < MinTime);
+    Report("MergeWithTourGPX", &M);
+
+    Sink = Sum;
+    (void) Sink;
+    return EXIT_SUCCESS;
+}
+
+static double Clock()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static unsigned long long CycleCount()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static void Reset(Measure * M)
+{
+    M->Time = 0;
+    M->Cycles = 0;
+    M->Ops = 0;
+}
+
+static void Begin(Measure * M)
+{
+    M->StartCycles = CycleCount();
+    M->StartTime = Clock();
+}
+
+static void End(Measure * M, long long Ops)
+{
+    double Time = Clock();
+    M->Cycles += CycleCount() - M->StartCycles;
+    M->Time += Time - M->StartTime;
+    M->Ops += Ops;
+}
+
+static void Report(char *Kernel, Measure * M)
+{
+    long long Ops = M->Ops > 0 ? M->Ops : 1;
+
+    if (M->Cycles > 0)
+        printf("%-24s %12.1f %12.1f %12lld\n", Kernel,
+               1e9 * M->Time / Ops, (double) M->Cycles / Ops, M->Ops);
+    else
+        printf("%-24s %12.1f %12s %12lld\n", Kernel,
+               1e9 * M->Time / Ops, "-", M->Ops);
+    fflush(stdout);
+}
+
+/*
+ * SaveTour returns the current tour (given by the Suc pointers) as an
+ * array of Dimension nodes starting at FirstNode.
+ */
+
+static Node **SaveTour()
+{
+    Node **Order = (Node **) malloc(Dimension * sizeof(Node *));
+    Node *N = FirstNode;
+    int i = 0;
+
+    do
+        Order[i++] = N;
+    while ((N = N->Suc) != FirstNode);
+    return Order;
+}
+
+/*
+ * SetTour makes the tour given by Order the current tour and numbers its
+ * nodes consecutively (Rank).
+ */
+
+static void SetTour(Node ** Order)
+{
+    Node *N, *Next;
+    int i;
+
+    for (i = 0; i < Dimension; i++) {
+        N = Order[i];
+        Next = Order[(i + 1) % Dimension];
+        N->Suc = N->OldSuc = Next;
+        Next->Pred = Next->OldPred = N;
+        N->Rank = i + 1;
+    }
+    FirstNode = Order[0];
+    Reversed = 0;
+    Swaps = 0;
+}
+
+/*
+ * AdjustC subtracts (Sign = -1) or adds (Sign = 1) the penalties to the
+ * explicit costs. CreateCandidateSet adds them after candidate
+ * generation, so they must be subtracted before the 1-tree is computed
+ * again.
+ */
+
+static void AdjustC(int Sign)
+{
+    Node *Na = FirstNode;
+    int i;
+
+    if (C != C_EXPLICIT)
+        return;
+    do
+        for (i = 1; i < Na->Id; i++)
+            Na->C[i] += Sign * (Na->Pi + NodeSet[i].Pi);
+    while ((Na = Na->Suc) != FirstNode);
+}
+
+/*
+ * RandomMove chooses a random 3-opt move, t[0..5], on the current tour of
+ * the kind tried first by SpecialMove: the edges (t1,t2), (t3,t4) and
+ * (t5,t6) are removed, where t2 = SUC(t1), t4 = SUC(t3), t6 = SUC(t5),
+ * and t5 lies between t2 and t3. No fixed edge is removed.
+ */
+
+static void RandomMove(Node ** t)
+{
+    for (;;) {
+        t[0] = &NodeSet[1 + Random() % Dimension];
+        t[1] = SUC(t[0]);
+        t[2] = &NodeSet[1 + Random() % Dimension];
+        t[3] = SUC(t[2]);
+        t[4] = &NodeSet[1 + Random() % Dimension];
+        t[5] = SUC(t[4]);
+        if (Fixed(t[0], t[1]) || Fixed(t[2], t[3]) || Fixed(t[4], t[5]) ||
+            t[2] == t[0] || t[2] == t[1] || t[2] == SUC(t[1]) ||
+            t[4] == t[0] || t[4] == t[2] || t[4] == t[3] ||
+            t[4] == SUC(t[3]) ||
+            !BETWEEN(t[1], t[4], t[2]))
+            continue;
+        return;
+    }
+}
@@ -11,6 +11,16 @@
 /*     -score returns the score                                              */
 /*    NOTE: nodes numbers in the tour arrays are 0 to ncount-1               */
 /*                                                                           */
+/*  JPTnormalize (int ncount, int **Cost, double *normCost)                  */
+/*    COMPUTES the normalized cost matrix used by the score                  */
+/*     -normCost returns the ncount*ncount matrix, stored row by row         */
+/*      (allocated by the caller)                                            */
+/*                                                                           */
+/*  JPTscore_normalized (int ncount, int *Atour, int *Btour,                 */
+/*          double *normCost, double *score)                                 */
+/*    COMPUTES the score as JPTscore from a matrix computed by JPTnormalize, */
+/*    so that several tours can be scored without normalizing again          */
+/*                                                                           */
 /*****************************************************************************/
 
 #include <stdio.h>
@@ -20,22 +30,42 @@
 #include <string.h>
 #include "JPTutil.h"
 
-static int erp_per_edit (int ncount, int *actual, int *sub, double **matrix,
+static int erp_per_edit (int ncount, int *actual, int *sub, double *matrix,
     double *erp);
-static void erp_per_edit_helper (int acount, int *actual, int scount, int *sub,
-    double **matrix, double **totalMemo, int **countMemo, double *total,
-    int *count);
 static int seq_dev (int ncount, int *Atour, int *Btour, double *dev);
-static int normalize_matrix (int ncount, int **M, double ***normM);
 
 int JPTscore (int ncount, int *Atour, int *Btour, int **Cost, double *score)
+{
+    int rval  = 0;
+    double *N = (double *) NULL;
+
+    N = (double *) malloc ((size_t) ncount * ncount * sizeof(double));
+    if (!N) {
+        fprintf (stderr, "out of memory for N\n"); rval = 1; goto CLEANUP;
+    }
+
+    rval = JPTnormalize (ncount, Cost, N);
+    if (rval) { fprintf(stderr, "JPTnormalize failed\n"); goto CLEANUP; }
+
+    rval = JPTscore_normalized (ncount, Atour, Btour, N, score);
+
+CLEANUP:
+    if (N) free(N);
+    return rval;
+}
+
+int JPTscore_normalized (int ncount, int *Atour, int *Btour, double *normCost,
+        double *score)
 {
     int rval  = 0, i, *A = (int *) NULL, *B = (int *) NULL;
-    double **N = (double **) NULL, dev = 0.0, erp = 0.0;
+    double dev = 0.0, erp = 0.0;
 
     rval = seq_dev (ncount, Atour, Btour, &dev);
     if (rval) { fprintf(stderr, "seq_dev failed\n"); goto CLEANUP; }
 
+    /* The score is dev*erp, so the edit distance is not needed */
+    if (dev == 0.0) { *score = 0.0; goto CLEANUP; }
+
     A = (int *) malloc((ncount+1)*sizeof(int));
     if (!A) {
         fprintf (stderr, "out of memory for A\n"); rval = 1; goto CLEANUP;
@@ -51,116 +81,85 @@ int JPTscore (int ncount, int *Atour, int *Btour, int **Cost, double *score)
     A[ncount] = Atour[0];
     B[ncount] = Btour[0];
 
-    rval = normalize_matrix (ncount, Cost, &N);
-    if (rval) { fprintf(stderr, "nomalize_matrix failed\n"); goto CLEANUP; }
-
-    rval = erp_per_edit(ncount, A, B, N, &erp);
+    rval = erp_per_edit(ncount, A, B, normCost, &erp);
     if (rval) { fprintf(stderr, "erp_per_edit failed\n"); goto CLEANUP; }
 
     *score = dev*erp;
 
 CLEANUP:
-    if (N) {
-        for (i = 0; i < ncount; i++) if (N[i]) free(N[i]);
-        free (N);
-    }
     if (A) free(A);
     if (B) free(B);
     return rval;
 }
 
-static int erp_per_edit (int ncount, int *actual, int *sub, double **matrix,
+/*  erp_per_edit computes the edit distance with real penalty (ERP) of   */
+/*  the sequences actual and sub (each of length ncount+1), divided by   */
+/*  the number of edits. A substitution of x by y costs                  */
+/*  matrix[x*ncount+y], a deletion or insertion costs 1000.              */
+/*                                                                       */
+/*  The DP runs over suffixes: row a holds the (total, count) values of  */
+/*  the last a elements of actual against the last s elements of sub,    */
+/*  s = 0, ..., ncount+1. Only two rows are kept. Ties are broken in     */
+/*  the order substitution, deletion, insertion.                         */
+
+static int erp_per_edit (int ncount, int *actual, int *sub, double *matrix,
         double *erp)
 {
-    int rval = 0, count = 0, **countMemo = (int **) NULL, i, j, n = ncount+2;
-    double total = 0.0, **totalMemo = (double **) NULL;
+    double *row;
+    int rval = 0, a, s, n = ncount+1, x, y;
+    int *prevCount = (int *) NULL, *curCount = (int *) NULL, *tc;
+    double *prevTotal = (double *) NULL, *curTotal = (double *) NULL, *tt;
+    double option1, option2, option3;
 
-    countMemo = (int **) malloc (n * sizeof(int *));
-    totalMemo = (double **) malloc (n * sizeof(double *));
-    if (!countMemo || !totalMemo) {
-        fprintf (stderr, "out of memory for memo matrices\n");
+    prevCount = (int *) malloc ((n+1) * sizeof(int));
+    curCount = (int *) malloc ((n+1) * sizeof(int));
+    prevTotal = (double *) malloc ((n+1) * sizeof(double));
+    curTotal = (double *) malloc ((n+1) * sizeof(double));
+    if (!prevCount || !curCount || !prevTotal || !curTotal) {
+        fprintf (stderr, "out of memory for DP rows\n");
         rval = 1; goto CLEANUP;
     }
-    for (i = 0; i < n; i++) {
-        countMemo[i] = (int *) malloc (n * sizeof(int));
-        totalMemo[i] = (double *) malloc (n * sizeof(double));
-        if (!countMemo[i] || !totalMemo[i]) {
-            fprintf (stderr, "out of memory for rows of memo matrices\n");
-            rval = 1; goto CLEANUP;
-        }
-        for (j = 0; j < n; j++) {
-            countMemo[i][j] = -1;
-            totalMemo[i][j] = -1.0;
+
+    for (s = 0; s <= n; s++) {
+        prevCount[s] = s;
+        prevTotal[s] = 1000.0 * (double) s;
+    }
+    for (a = 1; a <= n; a++) {
+        x = actual[n-a];
+        row = matrix + (size_t) x * ncount;
+        curCount[0] = a;
+        curTotal[0] = 1000.0 * (double) a;
+        for (s = 1; s <= n; s++) {
+            y = sub[n-s];
+            option1 = prevTotal[s-1] + row[y];
+            option2 = prevTotal[s] + 1000.0;
+            option3 = curTotal[s-1] + 1000.0;
+            if (option1 <= option2 && option1 <= option3) {
+                curTotal[s] = option1;
+                curCount[s] = prevCount[s-1] + (x != y);
+            } else if (option2 <= option1 && option2 <= option3) {
+                curTotal[s] = option2;
+                curCount[s] = prevCount[s] + 1;
+            } else {
+                curTotal[s] = option3;
+                curCount[s] = curCount[s-1] + 1;
+            }
         }
+        tt = prevTotal; prevTotal = curTotal; curTotal = tt;
+        tc = prevCount; prevCount = curCount; curCount = tc;
     }
 
-    erp_per_edit_helper (ncount+1, actual, ncount+1, sub, matrix,
-                         totalMemo, countMemo, &total, &count);
-
-    if (count == 0) *erp = 0.0;
-    else *erp = total / (double) count;
+    if (prevCount[n] == 0) *erp = 0.0;
+    else *erp = prevTotal[n] / (double) prevCount[n];
 
 CLEANUP:
-    if (countMemo) {
-        for (i = 0; i < n; i++) if (countMemo[i]) free(countMemo[i]);
-        free (countMemo);
-    }
-    if (totalMemo) {
-        for (i = 0; i < n; i++) if (totalMemo[i]) free(totalMemo[i]);
-        free (totalMemo);
-    }
+    if (prevCount) free(prevCount);
+    if (curCount) free(curCount);
+    if (prevTotal) free(prevTotal);
+    if (curTotal) free(curTotal);
     return rval;
 }
 
-static void erp_per_edit_helper (int acount, int *actual, int scount, int *sub,
-        double **matrix, double **totalMemo, int **countMemo, double *total,
-        int *count)
-{
-    int count1 = 0, count2 = 0, count3 = 0;
-    double score1 = 0.0, score2 = 0.0, score3 = 0.0;
-    double option1, option2, option3;
-
-    if (scount > 1 && acount > 1 && countMemo[scount][acount] != -1) {
-        *count = countMemo[scount][acount];
-        *total = totalMemo[scount][acount];
-        return;
-    }
-
-    if (scount == 0) {
-        *count = acount;
-        *total = 1000.0 * (double) acount;
-    } else if (acount == 0) {
-        *count = scount;
-        *total = 1000.0 * (double) scount;
-    } else {
-        erp_per_edit_helper(acount-1, actual+1, scount-1, sub+1, matrix,
-                            totalMemo, countMemo, &score1, &count1);
-        erp_per_edit_helper(acount-1, actual+1, scount, sub, matrix,
-                            totalMemo, countMemo, &score2, &count2);
-        erp_per_edit_helper(acount, actual, scount-1, sub+1, matrix,
-                            totalMemo, countMemo, &score3, &count3);
-        option1 = score1 + matrix[actual[0]][sub[0]];
-        option2 = score2 + 1000.0;
-        option3 = score3 + 1000.0;
-        if (option1 <= option2 && option1 <= option3) {
-            *total = option1;
-            if (actual[0] == sub[0]) *count = count1;
-            else                     *count = count1+1;
-        } else if (option2 <= option1 && option2 <= option3) {
-            *total = option2;
-            *count = count2+1;
-        } else {
-            *total = option3;
-            *count = count3+1;
-        }
-    }
-
-    if (scount > 1 && acount > 1) {
-        countMemo[scount][acount] = *count;
-        totalMemo[scount][acount] = *total;
-    }
-}
-
 static int seq_dev (int ncount, int *Atour, int *Btour, double *dev)
 {
     int rval = 0, i, *invperm = (int *) NULL, n = ncount-1;
@@ -192,52 +191,34 @@ CLEANUP:
     return rval;
 }
 
-static int normalize_matrix (int ncount, int **M, double ***normM)
+int JPTnormalize (int ncount, int **M, double *N)
 {
-    int rval = 0, i, j;
-    double **N = (double **) NULL, sum = 0.0, mean = 0.0, std = 0.0, x = 0.0;
-    double total = (double) (ncount*ncount);
+    int i, j;
+    double sum = 0.0, mean = 0.0, std = 0.0, x = 0.0, d;
+    double total = (double) ncount * ncount;
+    size_t n = (size_t) ncount * ncount, k;
 
-    N = (double **) malloc (ncount * sizeof(double *));
-    if (!N) {
-        fprintf (stderr, "out of memory for N\n"); rval = 1; goto CLEANUP;
-    }
     for (i = 0; i < ncount; i++) {
-        N[i] = (double *) malloc (ncount * sizeof(double));
-        if (!N[i]) {
-            fprintf (stderr, "out of memory for N[%d]\n", i);
-            rval = 1; goto CLEANUP;
-        }
         for (j = 0; j < ncount; j++) {
-            N[i][j] = (double) M[i][j];
-            sum += N[i][j];
+            N[(size_t) i * ncount + j] = (double) M[i][j];
+            sum += N[(size_t) i * ncount + j];
         }
     }
 
     mean = sum / total;
-    for (i = 0; i < ncount; i++) {
-        for (j = 0; j < ncount; j++) {
-            x += pow(N[i][j] - mean, 2);
-        }
+    for (k = 0; k < n; k++) {
+        d = N[k] - mean;
+        x += d * d;
     }
     std = sqrt(x/total);
 
     x = 1e30;
-    for (i = 0; i < ncount; i++) {
-        for (j = 0; j < ncount; j++) {
-            N[i][j] = (N[i][j] - mean) / std;
-            if (N[i][j] < x) x = N[i][j];
-        }
-    }
-
-    for (i = 0; i < ncount; i++) {
-        for (j = 0; j < ncount; j++) {
-            N[i][j] = N[i][j] - x;
-        }
+    for (k = 0; k < n; k++) {
+        N[k] = (N[k] - mean) / std;
+        if (N[k] < x) x = N[k];
     }
 
-    *normM = N;
+    for (k = 0; k < n; k++) N[k] = N[k] - x;
 
-CLEANUP:
-    return rval;
+    return 0;
 }
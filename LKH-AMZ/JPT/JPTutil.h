@@ -8,5 +8,8 @@
 #define __JPT_UTIL_H
 
 int JPTscore (int ncount, int *Atour, int *Btour, int **Cost, double *score);
+int JPTscore_normalized (int ncount, int *Atour, int *Btour, double *normCost,
+    double *score);
+int JPTnormalize (int ncount, int **Cost, double *normCost);
 
 #endif  /* __JPT_UTIL_H */
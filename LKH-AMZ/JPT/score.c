@@ -12,113 +12,192 @@
 #include <dirent.h>
 #include <float.h>
 #include <unistd.h>
+#include <pthread.h>
 #include "JPTutil.h"
 
-static char *tspname = (char *) NULL;
-static char *Aname = (char *) NULL;
-static char *Bname = (char *) NULL;
+/*  Usage: score [-t threads] directory [tour_directory ...]               */
+/*                                                                          */
+/*  Scores the tours in each tour_directory (default TOURS-directory)       */
+/*  against the tours in ACTUAL_TOURS, for the instances (*.ctsptw) in      */
+/*  directory, and prints the average score of each tour_directory.         */
+/*                                                                          */
+/*  The instances are scored by threads (default: the number of online      */
+/*  processors) in parallel. Each matrix is read and normalized once per    */
+/*  instance and used for all tour directories. The scores are summed in    */
+/*  alphabetical order of the instances, so the result does not depend on   */
+/*  the number of threads.                                                  */
+
+typedef struct instance {
+    char *name;
+    double *score;      /* one per tour directory, < 0 if not scored */
+} instance;
+
+static char *directory = (char *) NULL;
+static char **tourdirs = (char **) NULL;
+static int ntourdirs = 0, ninstances = 0, next_instance = 0;
+static instance *instances = (instance *) NULL;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 
-static int getTSP (char *fname, int *ncount, int ***M);
+static void *worker (void *arg);
+static int score_instance (instance *I);
+static int getTSP (char *fname, int *ncount, int **M);
 static int getTour (int ncount, char *fname, int *tour);
 
-double get_score (int ac, char **av)
+static void *worker (void *arg)
+{
+    int i;
+
+    (void) arg;
+    for (;;) {
+        pthread_mutex_lock (&lock);
+        i = next_instance++;
+        pthread_mutex_unlock (&lock);
+        if (i >= ninstances) break;
+        if (score_instance (&instances[i]))
+            fprintf (stderr, "%s: scoring failed\n", instances[i].name);
+    }
+    return (void *) NULL;
+}
+
+static int score_instance (instance *I)
 {
-    int rval  = 0, i, ncount = 0;
-    int **M = (int **) NULL, *Atour = (int *) NULL, *Btour = (int *) NULL;
-    double score = 0.0;
+    int rval  = 0, i, s, ncount = 0, *M = (int *) NULL, **rows = (int **) NULL;
+    int *Atour = (int *) NULL, *Btour = (int *) NULL;
+    double *N = (double *) NULL;
+    char tsp_file_name[1024], A_file_name[1024], B_file_name[1024];
 
-    Aname = av[0];
-    Bname = av[1];
-    tspname = av[2];
+    snprintf (A_file_name, sizeof(A_file_name), "ACTUAL_TOURS/%s.tour",
+              I->name);
+    snprintf (tsp_file_name, sizeof(tsp_file_name), "%s/%s.ctsptw",
+              directory, I->name);
+    if (access (A_file_name, F_OK) || access (tsp_file_name, F_OK))
+        goto CLEANUP;
 
-    rval = getTSP (tspname, &ncount, &M);
-    if (rval) { fprintf (stderr, "getTSP failed\n"); rval = 1; goto CLEANUP; }
+    rval = getTSP (tsp_file_name, &ncount, &M);
+    if (rval) { fprintf (stderr, "getTSP failed\n"); goto CLEANUP; }
 
-    Atour = (int *) malloc(ncount*sizeof(int));
-    if (!Atour) {
-        fprintf (stderr, "out of memory for Atour\n"); rval = 0; goto CLEANUP;
-    }
-    Btour = (int *) malloc(ncount*sizeof(int));
-    if (!Btour) {
-        fprintf (stderr, "out of memory for Btour\n"); rval = 0; goto CLEANUP;
+    rows = (int **) malloc (ncount * sizeof(int *));
+    N = (double *) malloc ((size_t) ncount * ncount * sizeof(double));
+    Atour = (int *) malloc (ncount * sizeof(int));
+    Btour = (int *) malloc (ncount * sizeof(int));
+    if (!rows || !N || !Atour || !Btour) {
+        fprintf (stderr, "out of memory for %s\n", I->name);
+        rval = 1; goto CLEANUP;
     }
-    rval = getTour (ncount, Aname, Atour);
-    if (rval) { fprintf (stderr, "getTour failed\n"); rval = 1; goto CLEANUP; }
-    rval = getTour (ncount, Bname, Btour);
-    if (rval) { fprintf (stderr, "getTour failed\n"); rval = 1; goto CLEANUP; }
+    for (i = 0; i < ncount; i++) rows[i] = M + (size_t) i * ncount;
+    rval = JPTnormalize (ncount, rows, N);
+    if (rval) { fprintf (stderr, "JPTnormalize failed\n"); goto CLEANUP; }
 
-    rval = JPTscore (ncount, Atour, Btour, M, &score);
-    if (rval) { fprintf (stderr, "JPTscore failed\n"); rval = 1; goto CLEANUP; }
+    rval = getTour (ncount, A_file_name, Atour);
+    if (rval) { fprintf (stderr, "getTour failed\n"); goto CLEANUP; }
 
-CLEANUP:
-
-    if (M) {
-        for (i = 0; i < ncount; i++) if (M[i]) free(M[i]);
-        free (M);
+    for (s = 0; s < ntourdirs; s++) {
+        snprintf (B_file_name, sizeof(B_file_name), "%s/%s.tour",
+                  tourdirs[s], I->name);
+        if (access (B_file_name, F_OK))
+            continue;
+        if (getTour (ncount, B_file_name, Btour)) {
+            fprintf (stderr, "getTour failed\n");
+            continue;
+        }
+        if (JPTscore_normalized (ncount, Atour, Btour, N, &I->score[s])) {
+            fprintf (stderr, "JPTscore failed\n");
+            I->score[s] = -1.0;
+        }
     }
+
+CLEANUP:
+    if (M) free (M);
+    if (rows) free (rows);
+    if (N) free (N);
     if (Atour) free (Atour);
     if (Btour) free (Btour);
-    return score;
+    return rval;
 }
 
-static int getTSP (char *fname, int *ncount, int ***M)
+/*  getTSP reads the dimension and the EDGE_WEIGHT_SECTION of a TSPLIB      */
+/*  file. The file is read into memory at once, and the matrix is parsed    */
+/*  by hand into one contiguous array (row by row).                         */
+
+static int getTSP (char *fname, int *ncount, int **M)
 {
-    char buf[256], key[256], field[256], *p;
     FILE *in = (FILE *) NULL;
-    int rval = 0, n = -1, **A = (int **) NULL;
+    int rval = 0, n = -1, *A = (int *) NULL, v, neg;
+    char *buf = (char *) NULL, *p, *key;
+    long size;
+    size_t i, k;
 
     *ncount = -1;
+    *M = (int *) NULL;
 
     if ((in = fopen (fname, "r")) == (FILE *) NULL) {
         fprintf (stderr, "Unable to open %s for input\n", fname);
         rval = 1; goto CLEANUP;
     }
+    if (fseek (in, 0, SEEK_END) || (size = ftell (in)) < 0 ||
+        fseek (in, 0, SEEK_SET)) {
+        fprintf (stderr, "Unable to read %s\n", fname);
+        rval = 1; goto CLEANUP;
+    }
+    buf = (char *) malloc (size + 1);
+    if (!buf) {
+        fprintf (stderr, "out of memory for buf\n"); rval = 1; goto CLEANUP;
+    }
+    size = (long) fread (buf, 1, size, in);
+    buf[size] = '\0';
 
-    while (fgets (buf, 254, in) != (char *) NULL) {
-        p = buf;
-        while (*p != '\0') {
-            if (*p == ':')
-                *p = ' ';
+    p = buf;
+    while (*p != '\0') {
+        while (*p == ' ' || *p == '\t' || *p == ':' || *p == '\n' ||
+               *p == '\r')
             p++;
-        }
-        p = buf;
-        if (sscanf (p, "%s", key) != EOF) {
-            p += strlen (key);
-            while (*p == ' ')
-                p++;
-            if (!strcmp (key, "DIMENSION")) {
-                if (sscanf (p, "%s", field) == EOF) {
-                    fprintf (stderr, "ERROR in DIMENSION line\n");
-                    return 1;
-                }
-                n = atoi (field);
-                *ncount = n;
-            } else if (!strcmp (key, "EDGE_WEIGHT_SECTION")) {
-                int i, j;
-                if (n == -1) {
-                    fprintf (stderr, "ERROR: Dimension not specified\n");
-                    rval = 1; goto CLEANUP;
-                }
-                A = (int **) malloc (n * sizeof(int *));
-                if (!A) {
-                    fprintf (stderr, "out of memory for A\n");
+        key = p;
+        while (*p != '\0' && *p != ' ' && *p != '\t' && *p != ':' &&
+               *p != '\n' && *p != '\r')
+            p++;
+        if (p - key == 9 && !strncmp (key, "DIMENSION", 9)) {
+            while (*p == ' ' || *p == '\t' || *p == ':') p++;
+            n = atoi (p);
+            *ncount = n;
+        } else if (p - key == 19 && !strncmp (key, "EDGE_WEIGHT_SECTION", 19)) {
+            if (n <= 0) {
+                fprintf (stderr, "ERROR: Dimension not specified\n");
+                rval = 1; goto CLEANUP;
+            }
+            k = (size_t) n * n;
+            A = (int *) malloc (k * sizeof(int));
+            if (!A) {
+                fprintf (stderr, "out of memory for A\n");
+                rval = 1; goto CLEANUP;
+            }
+            for (i = 0; i < k; i++) {
+                while (*p != '\0' && *p != '-' && (*p < '0' || *p > '9'))
+                    p++;
+                if (*p == '\0') {
+                    fprintf (stderr, "ERROR: EDGE_WEIGHT_SECTION too short\n");
                     rval = 1; goto CLEANUP;
                 }
-                for (i = 0; i < n; i++) {
-                    A[i] = (int *) malloc (n * sizeof(int));
-                    if (!A[i]) {
-                        fprintf (stderr, "out of memory for A[%d]\n", i);
-                        rval = 1; goto CLEANUP;
-                    }
-                    for (j = 0; j < n; j++) fscanf (in, "%d", &(A[i][j]));
-                }
-                *M = A;
+                neg = *p == '-';
+                if (neg) p++;
+                for (v = 0; *p >= '0' && *p <= '9'; p++)
+                    v = 10 * v + (*p - '0');
+                A[i] = neg ? -v : v;
             }
+            *M = A;
+            A = (int *) NULL;
+            break;
         }
+        while (*p != '\0' && *p != '\n') p++;
+    }
+    if (!*M) {
+        fprintf (stderr, "ERROR: No EDGE_WEIGHT_SECTION in %s\n", fname);
+        rval = 1;
     }
 
 CLEANUP:
     if (in) fclose (in);
+    if (buf) free (buf);
+    if (A) free (A);
     return rval;
 }
 
@@ -196,57 +275,96 @@ int file_select(const struct dirent *entry)
 
 int main(int ac, char **av)
 {
-    char *directory;
-    int files, i, count = 0;
-    double score_sum = 0;
+    int files, i, s, c, count, nthreads;
+    double score_sum;
     struct dirent **file_names;
-    char *name, delim[] = ".";
-    char tsp_file_name[256], A_file_name[256], B_file_name[256];
+    char *name, delim[] = ".", *default_tourdir = (char *) NULL, *label;
+    pthread_t *threads;
     DIR *dir;
 
-    if (ac == 1) {
-        fprintf (stderr, "Usage: %s directory\n", av[0]);
+    nthreads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+    while ((c = getopt (ac, av, "t:")) != -1) {
+        switch (c) {
+        case 't':
+            nthreads = atoi (optarg);
+            break;
+        default:
+            optind = ac;
+        }
+    }
+    if (optind >= ac) {
+        fprintf (stderr, "Usage: %s [-t threads] directory "
+                 "[tour_directory ...]\n", av[0]);
         exit(1);
     }
-    directory = av[1];
+    if (nthreads < 1) nthreads = 1;
+    directory = av[optind++];
+    if (optind < ac) {
+        tourdirs = av + optind;
+        ntourdirs = ac - optind;
+    } else {
+        default_tourdir = (char *) malloc (strlen (directory) + 7);
+        sprintf (default_tourdir, "TOURS-%s", directory);
+        tourdirs = &default_tourdir;
+        ntourdirs = 1;
+    }
     if ((dir = opendir("ACTUAL_TOURS")) == 0) {
         printf("Directory ACTUAL_TOURS does not exist\n");
         exit(1);
     }
     closedir(dir);
     files = scandir(directory, &file_names, file_select, alphasort);
+    if (files < 0) files = 0;
+    instances = (instance *) malloc ((files + 1) * sizeof(instance));
     for (i = 0; i < files; i++) {
         name = strtok(file_names[i]->d_name, delim);
         if (!name)
             continue;
-        strcpy(A_file_name, "ACTUAL_TOURS/");
-        strcat(A_file_name, name);
-        strcat(A_file_name, ".tour");
-        if (access(A_file_name, F_OK))
-            continue;
-        strcpy(B_file_name, "TOURS-");
-        strcat(B_file_name, directory);
-        strcat(B_file_name, "/");
-        strcat(B_file_name, name);
-        strcat(B_file_name, ".tour");
-        if (access(B_file_name, F_OK))
-            continue;
-        strcpy(tsp_file_name, directory);
-        strcat(tsp_file_name, "/");
-        strcat(tsp_file_name, name);
-        strcat(tsp_file_name, ".ctsptw");
-        if (access(tsp_file_name, F_OK))
-            continue;
-        char *av[3] = { A_file_name, B_file_name, tsp_file_name };
-        double score = get_score(3, av);
-//        printf("%s: Score = %0.5f\n", name, score);
-        score_sum += score;
+        instances[ninstances].name = strdup (name);
+        instances[ninstances].score =
+            (double *) malloc (ntourdirs * sizeof(double));
+        for (s = 0; s < ntourdirs; s++)
+            instances[ninstances].score[s] = -1.0;
+        ninstances++;
         free(file_names[i]);
-        count++;
     }
-//    printf("Tours: %d\n", count);
-    if (count > 0)
-        printf("Score %s: %0.5f\n", directory, score_sum / count);
-    else
-        printf("No score\n");
+    if (files > 0) free(file_names);
+
+    if (nthreads > ninstances) nthreads = ninstances;
+    threads = (pthread_t *) malloc ((nthreads + 1) * sizeof(pthread_t));
+    for (i = 0; i < nthreads; i++)
+        pthread_create (&threads[i], (pthread_attr_t *) NULL, worker,
+                        (void *) NULL);
+    for (i = 0; i < nthreads; i++)
+        pthread_join (threads[i], (void **) NULL);
+
+    for (s = 0; s < ntourdirs; s++) {
+        score_sum = 0.0;
+        count = 0;
+        for (i = 0; i < ninstances; i++) {
+            if (instances[i].score[s] < 0.0)
+                continue;
+//            printf("%s: Score = %0.5f\n", instances[i].name,
+//                   instances[i].score[s]);
+            score_sum += instances[i].score[s];
+            count++;
+        }
+//        printf("Tours: %d\n", count);
+        label = default_tourdir ? directory : tourdirs[s];
+        if (count > 0)
+            printf("Score %s: %0.5f\n", label, score_sum / count);
+        else if (default_tourdir)
+            printf("No score\n");
+        else
+            printf("No score %s\n", label);
+    }
+
+    for (i = 0; i < ninstances; i++) {
+        free (instances[i].name);
+        free (instances[i].score);
+    }
+    free (instances);
+    free (threads);
+    if (default_tourdir) free (default_tourdir);
+    return 0;
 }
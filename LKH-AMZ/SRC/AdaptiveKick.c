@@ -0,0 +1,111 @@
+#include "LKH.h"
+
+/*
+ * The AdaptiveKick function is called by ChooseInitialTour when
+ * ADAPTIVE_KICKING is YES. It chooses the perturbation of the current
+ * best tour to be used in the trial among the operators below:
+ *
+ *     K-swap kicks (KSwapKick) for K = 4, 6, and 8,
+ *     zone kicks (ZoneKSwapKick) for K = 4, 6, and 8, and
+ *     the construction of a new tour by a random walk (ChooseInitialTour).
+ *
+ * The reward of an operator is the number of trials in which it improved
+ * PENALTY_MULTIPLIER * penalty + cost of the best tour in the run, per
+ * second spent in these trials. The rate is used rather than the size of
+ * the improvements, since the latter is dominated by the large penalty
+ * decreases of the first trials of a run. The operator is chosen by the
+ * UCB1 rule: each operator is tried once; thereafter the operator
+ * maximizing
+ *
+ *     Rate / MaxRate + sqrt(2 * ln(Total) / Count)
+ *
+ * is chosen, where Rate is the operator's improvements per second,
+ * MaxRate the largest rate of any operator, Count the number of times
+ * the operator has been used, and Total the number of times any operator
+ * has been used. The statistics are kept across runs.
+ *
+ * The function returns 1 if a kick has been made on the current best
+ * tour. It returns 0 if the walk operator has been chosen, in which case
+ * the caller is to construct the tour.
+ *
+ * The AdaptiveKickReward function is called by FindTour after each trial
+ * with the penalty and cost of the tour found. It credits the operator
+ * used in the trial.
+ */
+
+typedef struct Operator {
+    int K;          /* K of the kick (0 for a random walk) */
+    int Zone;       /* Specifies whether it is a zone kick */
+    int Count;      /* Number of times the operator has been used */
+    double Reward;  /* Number of improvements it has given */
+    double Time;    /* Total time of the trials in which it was used */
+} Operator;
+
+static Operator Op[] = {
+    {4, 0, 0, 0, 0}, {6, 0, 0, 0, 0}, {8, 0, 0, 0, 0},
+    {4, 1, 0, 0, 0}, {6, 1, 0, 0, 0}, {8, 1, 0, 0, 0},
+    {0, 0, 0, 0, 0}
+};
+
+#define Operators ((int) (sizeof(Op) / sizeof(Op[0])))
+
+static int Chosen = -1, Total = 0;
+static double KickStartTime;
+
+int AdaptiveKick()
+{
+    Node *N, *Last;
+    double Score, BestScore = -1, MaxRate = 0;
+    int i;
+
+    for (i = 0; i < Operators; i++)
+        if (Op[i].Count > 0 && Op[i].Reward / Op[i].Time > MaxRate)
+            MaxRate = Op[i].Reward / Op[i].Time;
+    Chosen = Operators - 1;
+    for (i = 0; i < Operators; i++) {
+        if (Op[i].K > Dimension / 2)
+            continue;
+        if (Op[i].Count == 0) {
+            Chosen = i;
+            break;
+        }
+        Score = (MaxRate > 0 ? Op[i].Reward / Op[i].Time / MaxRate : 0) +
+            sqrt(2 * log(Total) / Op[i].Count);
+        if (Score > BestScore) {
+            BestScore = Score;
+            Chosen = i;
+        }
+    }
+    KickStartTime = GetTime();
+    if (Op[Chosen].K == 0)
+        return 0;
+    for (Last = FirstNode; (N = Last->BestSuc) != FirstNode; Last = N)
+        Follow(N, Last);
+    if (Op[Chosen].Zone)
+        ZoneKSwapKick(Op[Chosen].K);
+    else
+        KSwapKick(Op[Chosen].K);
+    return 1;
+}
+
+void AdaptiveKickReward(long long Penalty, long long Cost)
+{
+    double Gain, Time;
+
+    if (Chosen < 0)
+        return;
+    Gain = (double) PenaltyMultiplier * (BetterPenalty - Penalty) +
+        (BetterCost - Cost);
+    if ((Time = GetTime() - KickStartTime) < 1e-6)
+        Time = 1e-6;
+    Op[Chosen].Count++;
+    Op[Chosen].Time += Time;
+    if (Gain > 0)
+        Op[Chosen].Reward++;
+    Total++;
+    if (TraceLevel >= 3)
+        printff("Kick %d%s: Gain = %0.0f, Time = %0.3f\n",
+                Op[Chosen].K, Op[Chosen].Zone ? " ZONE" :
+                Op[Chosen].K == 0 ? " WALK" : "", Gain, Time);
+    Chosen = -1;
+}
@@ -17,6 +17,9 @@
  * 1-tree.The Generatecandidates function is called in order to generate 
  * candidate sets. Minimum 1-trees are then computed in the corresponding 
  * sparse graph.         
+ *
+ * If the time limit is reached, the subgradient optimization is stopped,
+ * and the best Pi-values found so far are used.
  */
 
 long long Ascent()
@@ -51,6 +54,8 @@ long long Ascent()
         /* Generate symmetric candididate sets for all nodes */
         MaxAlpha = INT_MAX;
         GenerateCandidates(AscentCandidates, MaxAlpha, 1);
+        if (Preempted())
+            goto End_Ascent;
     }
     if (TraceLevel >= 2) {
         CandidateReport();
@@ -76,6 +81,8 @@ long long Ascent()
                 ("  T = %d, Period = %d, BestW = %0.1f, BestNorm = %d\n",
                  T, Period, (double) BestW / Precision, BestNorm);
         for (P = 1; T && P <= Period && Norm != 0; P++) {
+            if (Preempted())
+                goto End_Ascent;
             /* Adjust the Pi-values */
             t = FirstNode;
             do {
@@ -145,6 +152,7 @@ long long Ascent()
         }
     }
 
+  End_Ascent:
     t = FirstNode;
     do {
         t->Pi = t->BestPi;
@@ -0,0 +1,26 @@
+#include "LKH.h"
+
+/*
+ * The BackboneCost function returns the sum of the distances of the fixed
+ * backbone edges (see UpdateBackbone) in the current tour (held in Suc).
+ *
+ * A fixed edge has distance 0 in the transformed problem (see D_FUNCTION),
+ * so a tour cost computed by summing C over the tour edges lacks the
+ * distances of the fixed backbone edges. The functions that compute the
+ * cost of a tour add the value returned by BackboneCost to obtain its
+ * real cost.
+ */
+
+long long BackboneCost()
+{
+    Node *N = FirstNode;
+    long long Sum = 0;
+
+    if (BackboneRuns == 0)
+        return 0;
+    do
+        if (N->BackboneFixedTo && N->BackboneFixedTo == N->Suc)
+            Sum += Distance(N, N->Suc);
+    while ((N = N->Suc) != FirstNode);
+    return Sum;
+}
@@ -24,6 +24,11 @@ int C_FUNCTION(Node * Na, Node * Nb)
     return D(Na, Nb);
 }
 
+/*
+ * A fixed edge, including a (temporarily) fixed backbone edge, has
+ * distance 0 (see UpdateBackbone and BackboneCost).
+ */
+
 int D_FUNCTION(Node * Na, Node * Nb)
 {
     return (Fixed(Na, Nb) ? 0 : Distance(Na, Nb) * Precision) + Na->Pi +
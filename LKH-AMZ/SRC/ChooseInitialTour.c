@@ -25,6 +25,17 @@
  *  among the alternatives (a one-way list of nodes).
  *
  *  The sequence of chosen nodes constitutes the initial tour.
+ *
+ *  If INITIAL_TOUR_ALGORITHM is ZONE (HIERARCHICAL), the initial tour of
+ *  the first trial is instead constructed by the ZoneInitialTour
+ *  (HierarchicalInitialTour) function.
+ *
+ *  If an initial tour has been given (INITIAL_TOUR_FILE), that tour is
+ *  used in the first trial.
+ *
+ *  In the following trials, the current best tour is perturbed by a kick
+ *  (KICK_TYPE > 0). If ADAPTIVE_KICKING is YES, the kick is chosen by the
+ *  AdaptiveKick function, which may also choose the construction above.
  */
 
 void ChooseInitialTour()
@@ -33,13 +44,35 @@ void ChooseInitialTour()
     Candidate *NN;
     int Alternatives, Count, i;
     
-    if (KickType > 0 && Trial > 1) {
+    if (AdaptiveKicking && Trial > 1) {
+        if (AdaptiveKick())
+            return;
+    } else if (KickType > 0 && Trial > 1) {
         for (Last = FirstNode; (N = Last->BestSuc) != FirstNode; Last = N)
             Follow(N, Last);
-        KSwapKick(KickType);
+        if (ZoneKick)
+            ZoneKSwapKick(KickType);
+        else
+            KSwapKick(KickType);
         return;
     }
-    
+    if (Trial == 1 && FirstNode->InitialSuc) {
+        for (Last = FirstNode; (N = Last->InitialSuc) != FirstNode; Last = N)
+            Follow(N, Last);
+        goto End_ChooseInitialTour;
+    }
+    if (InitialTourAlgorithm != WALK && Trial == 1 && GTSPSets > 1) {
+        long long Cost = InitialTourAlgorithm == ZONE ? ZoneInitialTour() :
+            HierarchicalInitialTour();
+        if (Cost != LLONG_MAX) {
+            if (MaxTrials == 0 && Cost < BetterCost) {
+                BetterCost = Cost;
+                RecordBetterTour();
+            }
+            return;
+        }
+    }
+
 Start:
     /* Mark all nodes as "not chosen" by setting their V field to zero */
     N = FirstNode;
@@ -54,6 +87,7 @@ Start:
             break;
     }
     while ((N = N->Suc) != FirstNode);
+    FirstNode = N;
     
     /* Move nodes with two incident fixed or common candidate edges in
        front of FirstNode */
@@ -130,13 +164,14 @@ Start:
         FirstNode = N;
         goto Start;
     }
+End_ChooseInitialTour:
     if (MaxTrials == 0) {
         long long Cost = 0;
         N = FirstNode;
         do
             Cost += C(N, N->Suc) - N->Pi - N->Suc->Pi;
         while ((N = N->Suc) != FirstNode);
-        Cost /= Precision;
+        Cost = Cost / Precision + BackboneCost();
         if (Cost < BetterCost) {
             BetterCost = Cost;
             RecordBetterTour();
@@ -11,6 +11,13 @@
  *
  * The function GenerateCandidates is called to compute the Alpha-values and to 
  * associate to each node a set of incident candidate edges.  
+ * Edges that violate zone precedences or time windows may then be pruned
+ * by the PruneZoneCandidates function (ZONE_PRUNING) and the
+ * PruneTimeWindowCandidates function (TIME_WINDOW_PRUNING).
+ *
+ * If CANDIDATE_SET_TYPE is NEAREST-NEIGHBOR, the ascent is skipped, and
+ * the candidate set is created by the CreateNearestNeighborCandidateSet
+ * function. No lower bound is computed in that case.
  *
  * The CreateCandidateSet function itself is called from LKHmain.
  */
@@ -20,7 +27,7 @@ void CreateCandidateSet()
     long long Cost, MaxAlpha;
     Node *Na;
     int i;
-    double EntryTime = GetTime();
+    double EntryTime = GetTime(), WallTime, GenerateTime;
 
     Norm = 9999;
     if (C == C_EXPLICIT) {
@@ -37,29 +44,41 @@ void CreateCandidateSet()
     do
         Na->Pi = 0;
     while ((Na = Na->Suc) != FirstNode);
-    Cost = Ascent();
-    if (MaxCandidates > 0) {
-        if (TraceLevel >= 2)
-            printff("Computing lower bound ... ");
-        Cost = Minimum1TreeCost(0);
-        if (TraceLevel >= 2)
-            printff("done\n");
-    } else {
-        if (TraceLevel >= 2)
-            printff("Computing lower bound ... ");
-        Cost = Minimum1TreeCost(1);
-        if (TraceLevel >= 2)
-            printff("done\n");
-    }
-    LowerBound = (double) Cost / Precision;
-    if (TraceLevel >= 1) {
-        printff("Lower bound = %0.1f", LowerBound);
-        printff(", Ascent time = %0.2f sec.",
-                fabs(GetTime() - EntryTime));
-        printff("\n");
+    if (CandidateSetType == NN && MaxCandidates > 0)
+        CreateNearestNeighborCandidateSet(MaxCandidates);
+    else {
+        WallTime = GetWallTime();
+        GenerateTime = Stats.GenerateCandidatesTime;
+        Cost = Ascent();
+        if (MaxCandidates > 0) {
+            if (TraceLevel >= 2)
+                printff("Computing lower bound ... ");
+            Cost = Minimum1TreeCost(0);
+            if (TraceLevel >= 2)
+                printff("done\n");
+        } else {
+            if (TraceLevel >= 2)
+                printff("Computing lower bound ... ");
+            Cost = Minimum1TreeCost(1);
+            if (TraceLevel >= 2)
+                printff("done\n");
+        }
+        Stats.AscentTime = GetWallTime() - WallTime -
+            (Stats.GenerateCandidatesTime - GenerateTime);
+        LowerBound = (double) Cost / Precision;
+        if (TraceLevel >= 1) {
+            printff("Lower bound = %0.1f", LowerBound);
+            printff(", Ascent time = %0.2f sec.",
+                    fabs(GetTime() - EntryTime));
+            printff("\n");
+        }
+        MaxAlpha = (long long) fabs(Excess * Cost);
+        GenerateCandidates(MaxCandidates, MaxAlpha, CandidateSetSymmetric);
     }
-    MaxAlpha = (long long) fabs(Excess * Cost);
-    GenerateCandidates(MaxCandidates, MaxAlpha, CandidateSetSymmetric);
+    if (ZonePruning != NO_PRUNING)
+        PruneZoneCandidates();
+    if (TimeWindowPruning != NO_PRUNING)
+        PruneTimeWindowCandidates();
 
     if (MaxTrials > 0) {
         Na = FirstNode;
@@ -0,0 +1,181 @@
+#include "LKH.h"
+#include <pthread.h>
+
+/*
+ * The CreateNearestNeighborCandidateSet function associates to each node
+ * its K nearest neighbors as candidates (CANDIDATE_SET_TYPE =
+ * NEAREST-NEIGHBOR). No subgradient optimization (Ascent) and no
+ * computation of Alpha-values is made, so all Pi-values are zero.
+ *
+ * For an ATSP instance (the transformed problem), a neighbor of an
+ * original node i is a twin node, and the candidate edge (i,Twin(j))
+ * represents going from i to j. Likewise, the candidate edge (Twin(i),j)
+ * represents going from j to i. Thus, each node is given its K nearest
+ * successors and its K nearest predecessors in the cost matrix.
+ *
+ * The neighbors of each node are found by partial selection: a scan of
+ * all nodes, keeping the K nearest ones found so far in a sorted array
+ * (see FindNeighbors). The scans are distributed over CANDIDATE_THREADS
+ * threads. With sparse costs (SPARSE_NEIGHBORS > 0), only the nodes whose
+ * costs are stored, and the ends of fixed edges, are scanned. The
+ * Alpha-value of a candidate edge is 0 for a fixed edge (fixed edges are
+ * always candidates), and otherwise its rank among the non-fixed
+ * neighbors of the node, starting at 1.
+ *
+ * As in GenerateCandidates, tour candidates are added (AddTourCandidates),
+ * and the candidate set is symmetrized if CandidateSetSymmetric is
+ * non-zero.
+ */
+
+static int K;
+static Node **Neighbor;         /* Neighbor[(Id - 1) * K + i]: the i'th
+                                   nearest neighbor of node Id */
+static long long *Key;          /* Key[(Id - 1) * K + i]: its key */
+
+static void *FindNeighbors(void *Thread);
+static int Select(Node * From, Node ** N, long long *Kn, int Count,
+                  int Max, int Travel);
+
+void CreateNearestNeighborCandidateSet(int MaxCandidates)
+{
+    Node *From, *To;
+    pthread_t *Thread;
+    long *Id;
+    int Threads = CandidateThreads, Rank, i, j;
+    double WallTime = GetWallTime();
+
+    if (TraceLevel >= 2)
+        printff("Creating nearest neighbor candidates ... ");
+    if ((K = MaxCandidates) > Dimension - 1)
+        K = Dimension - 1;
+    Neighbor = (Node **) malloc((size_t) Dimension * K * sizeof(Node *));
+    Key = (long long *) malloc((size_t) Dimension * K * sizeof(long long));
+    if (Threads > Dimension)
+        Threads = Dimension;
+    if (Threads <= 1)
+        FindNeighbors(0);
+    else {
+        Thread = (pthread_t *) malloc(Threads * sizeof(pthread_t));
+        Id = (long *) malloc(Threads * sizeof(long));
+        for (i = 0; i < Threads; i++) {
+            Id[i] = i;
+            if (pthread_create(&Thread[i], 0, FindNeighbors, &Id[i]))
+                eprintf("CANDIDATE_THREADS: Cannot create thread");
+        }
+        for (i = 0; i < Threads; i++)
+            pthread_join(Thread[i], 0);
+        free(Thread);
+        free(Id);
+    }
+
+    From = FirstNode;
+    do {
+        From->CandidateSet = (Candidate *) calloc(1, sizeof(Candidate));
+        for (j = 0, Rank = 1; j < K; j++) {
+            if (!(To = Neighbor[(From->Id - 1) * K + j]))
+                break;
+            AddCandidate(From, To, D(From, To),
+                         Fixed(From, To) ? 0 : Rank++);
+        }
+    }
+    while ((From = From->Suc) != FirstNode);
+    free(Neighbor);
+    free(Key);
+
+    AddTourCandidates();
+    if (CandidateSetSymmetric)
+        SymmetrizeCandidateSet();
+    Stats.GenerateCandidatesTime += GetWallTime() - WallTime;
+    if (TraceLevel >= 2)
+        printff("done\n");
+}
+
+/*
+ * The FindNeighbors function finds the K nearest neighbors of the nodes
+ * handled by the thread with the given number (every Threads'th node).
+ * The first K - K / 2 neighbors are the nearest ones with respect to the
+ * cost; the remaining ones are the nearest of the other nodes with
+ * respect to travel time, i.e., the cost without the MM added to edges
+ * between clusters. In this way, a node on the border of its cluster also
+ * gets candidate edges to the nearby clusters.
+ */
+
+static void *FindNeighbors(void *Thread)
+{
+    Node *From, **N;
+    long long *Kn;
+    int Threads = Thread ? CandidateThreads : 1, Count, Id;
+
+    if (Threads > Dimension)
+        Threads = Dimension;
+    for (Id = 1 + (Thread ? *(long *) Thread : 0); Id <= Dimension;
+         Id += Threads) {
+        From = &NodeSet[Id];
+        N = &Neighbor[(Id - 1) * K];
+        Kn = &Key[(Id - 1) * K];
+        Count = Select(From, N, Kn, 0, K - K / 2, 0);
+        Count = Select(From, N, Kn, Count, K, 1);
+        if (Count < K)
+            N[Count] = 0;
+    }
+    return 0;
+}
+
+/*
+ * The Select function extends the sorted array N[0..Count-1] of neighbors
+ * of From with the nearest nodes not already in the array, until it holds
+ * Max nodes. If Travel is non-zero, the nodes are compared by travel time;
+ * otherwise by cost. Fixed edges are given the smallest key, so that they
+ * are always found. Forbidden edges, and edges incident to a node with
+ * two fixed edges, are skipped. The function returns the new number of
+ * nodes in the array.
+ *
+ * With sparse costs, the nodes scanned are the two ends of fixed edges
+ * (FixedTo1 and FixedTo2) followed by the nodes of the sparse list of
+ * From (see Distance_SPARSE).
+ */
+
+static int Select(Node * From, Node ** N, long long *Kn, int Count,
+                  int Max, int Travel)
+{
+    Node *To;
+    long long k;
+    int First = Count, Sparse = Distance == Distance_SPARSE, Last, Twin, i,
+        j;
+
+    Last = Sparse ? From->SparseCount + 2 : Dimension;
+    Twin = From->Id <= DimensionSaved ? DimensionSaved : 0;
+    for (j = 1; j <= Last; j++) {
+        To = !Sparse ? &NodeSet[j] :
+            j == 1 ? From->FixedTo1 :
+            j == 2 ? From->FixedTo2 :
+            &NodeSet[From->SparseId[j - 3] + Twin];
+        if (!To || To == From)
+            continue;
+        if (Fixed(From, To)) {
+            if (Sparse && j > 2)
+                continue;
+            k = LLONG_MIN;
+        } else if (From->FixedTo2 || To->FixedTo2 || Forbidden(From, To))
+            continue;
+        else {
+            k = D(From, To);
+            if (Travel && From->MyCluster != To->MyCluster)
+                k -= MM * Precision;
+        }
+        if (Count == Max && k >= Kn[Max - 1])
+            continue;
+        for (i = 0; i < First && N[i] != To; i++);
+        if (i < First)
+            continue;
+        /* Insert To into the sorted array N[First..Max-1] */
+        for (i = Count < Max ? Count++ : Max - 1;
+             i > First && Kn[i - 1] > k; i--) {
+            N[i] = N[i - 1];
+            Kn[i] = Kn[i - 1];
+        }
+        N[i] = To;
+        Kn[i] = k;
+    }
+    return Count;
+}
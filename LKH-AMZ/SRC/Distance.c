@@ -6,6 +6,10 @@
  * The appropriate function is referenced by the function pointer Distance.
  */
 
+#define EARTH_RADIUS 6371000.0
+
+static int Lookup(Node * N, int Id);
+
 int Distance_ATSP(Node * Na, Node * Nb)
 {
     int n = DimensionSaved;
@@ -20,3 +24,90 @@ int Distance_EXPLICIT(Node * Na, Node * Nb)
 {
     return Na->Id < Nb->Id ? Nb->C[Na->Id] : Na->C[Nb->Id];
 }
+
+/*
+ * The Distance_SPARSE function is used instead of Distance_ATSP when only
+ * the costs of the SPARSE_NEIGHBORS nearest successors and predecessors of
+ * each node are stored (see ReadProblem). The cost of going from node i
+ * to node j is looked up in the sparse list of i (its nearest successors)
+ * and in the sparse list of Twin(j) (the nearest predecessors of j).
+ *
+ * If the cost is stored in neither list, it is estimated. Since j is not
+ * among the nearest successors of i, the cost is at least the largest
+ * stored cost of i, and likewise at least the largest stored cost of
+ * Twin(j). This lower bound is raised to an estimate of the cost, if
+ * larger: the great circle distance between i and j times SparseScale,
+ * if coordinates have been given, and otherwise the average of the
+ * largest stored costs and the mean costs that are not stored
+ * (SparseMean) of i and Twin(j). The latter estimate lies between the
+ * costs just beyond the nearest neighbors, which the search is most
+ * likely to use, and the mean of all the costs that are not stored. The
+ * estimate never exceeds M, the largest cost of the problem.
+ *
+ * The MM-value of the CTSP transform is added here to the costs between
+ * clusters, since there is no cost matrix for the transform to change.
+ */
+
+int Distance_SPARSE(Node * Na, Node * Nb)
+{
+    int n = DimensionSaved, W;
+    Node *From, *To;
+    double E;
+
+    if ((Na->Id <= n) == (Nb->Id <= n))
+        return M;
+    if (abs(Na->Id - Nb->Id) == n)
+        return 0;
+    if (Na->Id > n) {
+        From = Na;
+        Na = Nb;
+        Nb = From;
+    }
+    From = Na;
+    To = &NodeSet[Nb->Id - n];
+    if ((W = Lookup(From, To->Id)) == INT_MIN &&
+        (W = Lookup(Nb, From->Id)) == INT_MIN) {
+        W = From->SparseMax > Nb->SparseMax ? From->SparseMax :
+            Nb->SparseMax;
+        E = SparseScale > 0 ? SparseScale * GreatCircleDistance(From, To) :
+            (From->SparseMax + From->SparseMean +
+             Nb->SparseMax + Nb->SparseMean) / 4.0;
+        if (E > W)
+            W = E < M ? (int) (E + 0.5) : M;
+    }
+    return From->MyCluster != To->MyCluster ? (int) (W + MM) : W;
+}
+
+/*
+ * The GreatCircleDistance function returns the distance in meters
+ * between the coordinates of two nodes (haversine formula).
+ */
+
+double GreatCircleDistance(Node * Na, Node * Nb)
+{
+    double SinDLat = sin((Nb->Lat - Na->Lat) / 2),
+        SinDLng = sin((Nb->Lng - Na->Lng) / 2),
+        A = SinDLat * SinDLat + Na->CosLat * Nb->CosLat * SinDLng * SinDLng;
+    return 2 * EARTH_RADIUS * asin(A < 1 ? sqrt(A) : 1);
+}
+
+/*
+ * The Lookup function returns the stored cost for node Id in the sparse
+ * list of node N (binary search), or INT_MIN if it is not stored.
+ */
+
+static int Lookup(Node * N, int Id)
+{
+    int Low = 0, High = N->SparseCount - 1, Mid;
+
+    while (Low <= High) {
+        Mid = (Low + High) / 2;
+        if (N->SparseId[Mid] == Id)
+            return N->SparseCost[Mid];
+        if (N->SparseId[Mid] < Id)
+            Low = Mid + 1;
+        else
+            High = Mid - 1;
+    }
+    return INT_MIN;
+}
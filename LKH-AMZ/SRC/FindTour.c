@@ -40,11 +40,14 @@ long long FindTour()
     }
     PrepareKicking();
     for (Trial = 1; Trial <= MaxTrials; Trial++) {
-        if (Trial > 1 && GetTime() - StartTime >= TimeLimit) {
+        if (Trial > 1 && TimeLimitExceeded()) {
             if (TraceLevel >= 1)
                 printff("*** Time limit exceeded ***\n");
             break;
         }
+        if (Trial > 1 && Stagnated())
+            break;
+        WriteCheckpoint(0, 0, 0);
         /* Choose FirstNode at random */
         if (Dimension == DimensionSaved)
             FirstNode = &NodeSet[1 + Random() % Dimension];
@@ -52,7 +55,11 @@ long long FindTour()
             for (i = Random() % Dimension; i > 0; i--)
                 FirstNode = FirstNode->Suc;
         ChooseInitialTour();
+        Stats.Trials++;
         Cost = LinKernighan();
+        if (AdaptiveKicking)
+            AdaptiveKickReward(CurrentPenalty, Cost);
+        RecordProgress(CurrentPenalty, Cost - GTSPSets * MM, 1);
         if (CurrentPenalty < BetterPenalty ||
             (CurrentPenalty == BetterPenalty && Cost < BetterCost)) {
             if (TraceLevel >= 1) {
@@ -61,7 +68,11 @@ long long FindTour()
             }
             BetterCost = Cost;
             BetterPenalty = CurrentPenalty;
+            WriteConvergence('B', CurrentPenalty, Cost - GTSPSets * MM);
             RecordBetterTour();
+            WriteCheckpoint(BetterTour,
+                            PenaltyMultiplier * CurrentPenalty + Cost -
+                            GTSPSets * MM, Cost - GTSPSets * MM);
             AdjustCandidateSet();
             PrepareKicking();
             if (HashingUsed) {
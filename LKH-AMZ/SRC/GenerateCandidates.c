@@ -27,6 +27,10 @@
  *      An Effective Implementation of the Lin-Kernighan Traveling 
  *      Salesman Heuristic,
  *      Report, RUC, 1998. 
+ *
+ * The time limit is checked for every 16 nodes. If it has been reached,
+ * the remaining nodes are given the edges of the current minimum 1-tree
+ * as candidates.
  */
 
 static int Max(const int a, const int b)
@@ -39,7 +43,8 @@ void GenerateCandidates(int MaxCandidates, long long MaxAlpha,
 {
     Node *From, *To;
     Candidate *NFrom, *NN;
-    int a, d, Count;
+    int a, d, Count, Nodes = 0;
+    double WallTime = GetWallTime();
 
     if (TraceLevel >= 2)
         printff("Generating candidates ... ");
@@ -65,11 +70,25 @@ void GenerateCandidates(int MaxCandidates, long long MaxAlpha,
             if (!From->CandidateSet)
                 eprintf("MAX_CANDIDATES = 0: No candidates");
         } while ((From = From->Suc) != FirstNode);
+        Stats.GenerateCandidatesTime += GetWallTime() - WallTime;
         return;
     }
 
     /* Loop for each node, From */
     do {
+        if ((++Nodes & 15) == 0 && Preempted()) {
+            /* Use the 1-tree edges as candidates */
+            do {
+                if ((To = From->Dad)) {
+                    AddCandidate(From, To, D(From, To), 0);
+                    AddCandidate(To, From, D(From, To), 0);
+                }
+            } while ((From = From->Suc) != FirstNode);
+            if (TraceLevel >= 1)
+                printff("*** Time limit exceeded: "
+                        "1-tree candidates used ***\n");
+            break;
+        }
         NFrom = From->CandidateSet;
         if (From != FirstNode) {
             From->Beta = INT_MIN;
@@ -148,6 +167,7 @@ void GenerateCandidates(int MaxCandidates, long long MaxAlpha,
     AddTourCandidates();
     if (Symmetric)
         SymmetrizeCandidateSet();
+    Stats.GenerateCandidatesTime += GetWallTime() - WallTime;
     if (TraceLevel >= 2)
         printff("done\n");
 }
@@ -0,0 +1,262 @@
+#include "LKH.h"
+#include "Genetic.h"
+
+/*
+ * This file contains the functions of the genetic algorithm that is used
+ * when POPULATION_SIZE > 1.
+ *
+ * The population consists of at most MaxPopulationSize distinct local
+ * optima, each stored as an array of node numbers (as BestTour). Two
+ * individuals are distinct if they differ in penalty, cost, or hash
+ * value. Each run starts from the offspring of two individuals chosen by
+ * linear selection (ApplyCrossover), and the resulting tour replaces the
+ * worse individual that is closest to it (ReplacementIndividual), such
+ * that the population keeps its diversity.
+ */
+
+int MaxPopulationSize;
+int PopulationSize;
+int **Population;
+long long *PenaltyFitness;
+long long *Fitness;
+unsigned *TourHash;
+
+static int *Tour = 0;    /* The current tour */
+static int *SucTour = 0; /* Successor of each node in an individual */
+
+static void RecordTour(void);
+static unsigned HashValue(int *T);
+static int TourDistance(int *T1, int *T2);
+static void SetNext(int *T);
+
+/*
+ * The AddToPopulation function adds the current tour as an individual to
+ * the population. The fitness of the individual is given by Penalty and
+ * Cost.
+ */
+
+void AddToPopulation(long long Penalty, long long Cost)
+{
+    int i, *P;
+
+    if (!Population) {
+        Population = (int **) malloc(MaxPopulationSize * sizeof(int *));
+        for (i = 0; i < MaxPopulationSize; i++)
+            Population[i] = (int *) malloc((1 + DimensionSaved) * sizeof(int));
+        PenaltyFitness =
+            (long long *) malloc(MaxPopulationSize * sizeof(long long));
+        Fitness = (long long *) malloc(MaxPopulationSize * sizeof(long long));
+        TourHash = (unsigned *) malloc(MaxPopulationSize * sizeof(unsigned));
+    }
+    RecordTour();
+    for (i = PopulationSize; i >= 1 && SmallerFitness(Penalty, Cost, i - 1);
+         i--) {
+        P = Population[i];
+        Population[i] = Population[i - 1];
+        Population[i - 1] = P;
+        PenaltyFitness[i] = PenaltyFitness[i - 1];
+        Fitness[i] = Fitness[i - 1];
+        TourHash[i] = TourHash[i - 1];
+    }
+    memcpy(Population[i], Tour, (1 + DimensionSaved) * sizeof(int));
+    PenaltyFitness[i] = Penalty;
+    Fitness[i] = Cost;
+    TourHash[i] = HashValue(Tour);
+    PopulationSize++;
+}
+
+/*
+ * The ApplyCrossover function merges individual i (T1) with individual j
+ * (T2) by MergeWithTour, or by MergeWithTourGPX if MERGE_ALGORITHM is GPX.
+ * The offspring becomes the initial tour of the next run (InitialSuc).
+ */
+
+void ApplyCrossover(int i, int j)
+{
+    Node *N;
+
+    SetNext(Population[i]);
+    N = FirstNode;
+    do
+        (N->Suc = N->Next)->Pred = N;
+    while ((N = N->Suc) != FirstNode);
+    SetNext(Population[j]);
+    if (MergeAlgorithm == GPX)
+        MergeWithTourGPX();
+    else
+        MergeWithTour();
+    do
+        N->InitialSuc = N->Suc;
+    while ((N = N->Suc) != FirstNode);
+}
+
+/*
+ * The HasTour function returns 1 if the current tour, with the given
+ * Penalty and Cost, is already in the population; otherwise 0.
+ */
+
+int HasTour(long long Penalty, long long Cost)
+{
+    unsigned Hash;
+    int i;
+
+    RecordTour();
+    Hash = HashValue(Tour);
+    for (i = 0; i < PopulationSize; i++)
+        if (Penalty == PenaltyFitness[i] && Cost == Fitness[i] &&
+            Hash == TourHash[i])
+            return 1;
+    return 0;
+}
+
+/*
+ * The LinearSelection function picks an individual at random with a
+ * probability that decreases linearly with its rank in the population.
+ * Bias (1 < Bias <= 2) is the ratio between the probability of the best
+ * individual and the average probability.
+ */
+
+int LinearSelection(int Size, double Bias)
+{
+    double r = (double) Random() / INT_MAX;
+
+    return (int) (Size * (Bias - sqrt(Bias * Bias - 4 * (Bias - 1) * r)) /
+                  (2 * (Bias - 1)));
+}
+
+/*
+ * The PrintPopulation function prints the fitness of each individual,
+ * and its distance (number of differing edges) to the best individual.
+ */
+
+void PrintPopulation()
+{
+    int i;
+
+    printff("Population:\n");
+    for (i = 0; i < PopulationSize; i++)
+        printff("%3d: %lld_%lld, distance = %d\n", i + 1,
+                PenaltyFitness[i], Fitness[i],
+                i > 0 ? TourDistance(Population[i], Population[0]) : 0);
+}
+
+/*
+ * The ReplaceIndividualWithTour function replaces individual i with the
+ * current tour, and restores the order of the population.
+ */
+
+void ReplaceIndividualWithTour(int i, long long Penalty, long long Cost)
+{
+    int j, *P = Population[i];
+
+    for (j = i; j < PopulationSize - 1; j++) {
+        Population[j] = Population[j + 1];
+        PenaltyFitness[j] = PenaltyFitness[j + 1];
+        Fitness[j] = Fitness[j + 1];
+        TourHash[j] = TourHash[j + 1];
+    }
+    Population[PopulationSize - 1] = P;
+    PopulationSize--;
+    AddToPopulation(Penalty, Cost);
+}
+
+/*
+ * The ReplacementIndividual function returns the individual to be
+ * replaced by the current tour: among the individuals that are worse
+ * than the tour, the one with the fewest edges not in the tour. Thus,
+ * the tour replaces a worse tour in its own region of the search space
+ * rather than the worst tour, which keeps the population diverse.
+ */
+
+int ReplacementIndividual(long long Penalty, long long Cost)
+{
+    int i, d, MinDistance = INT_MAX, Min = PopulationSize - 1;
+
+    RecordTour();
+    for (i = PopulationSize - 1; i >= 0 && SmallerFitness(Penalty, Cost, i);
+         i--) {
+        if ((d = TourDistance(Population[i], Tour)) < MinDistance) {
+            MinDistance = d;
+            Min = i;
+        }
+    }
+    return Min;
+}
+
+/*
+ * RecordTour records the current tour (given by the Suc pointers) in the
+ * array Tour in the same way as RecordBetterTour.
+ */
+
+static void RecordTour()
+{
+    Node *N = Depot;
+    int i;
+
+    if (!Tour) {
+        Tour = (int *) malloc((1 + DimensionSaved) * sizeof(int));
+        SucTour = (int *) malloc((1 + DimensionSaved) * sizeof(int));
+    }
+    if (N->Suc->Id != DimensionSaved + N->Id) {
+        i = 1;
+        do
+            if (N->Id <= DimensionSaved)
+                Tour[i++] = N->Id;
+        while ((N = N->Suc) != Depot);
+    } else {
+        i = DimensionSaved;
+        do
+            if (N->Id <= DimensionSaved)
+                Tour[i--] = N->Id;
+        while ((N = N->Suc) != Depot);
+    }
+    Tour[0] = Tour[DimensionSaved];
+}
+
+static unsigned HashValue(int *T)
+{
+    unsigned Hash = 0;
+    int i;
+
+    for (i = 1; i <= DimensionSaved; i++)
+        Hash ^= (2654435761u * T[i - 1]) * (2246822519u * T[i] + 1);
+    return Hash;
+}
+
+/*
+ * TourDistance returns the number of edges of tour T1 that are not in
+ * tour T2.
+ */
+
+static int TourDistance(int *T1, int *T2)
+{
+    int i, d = 0;
+
+    for (i = 1; i <= DimensionSaved; i++)
+        SucTour[T2[i - 1]] = T2[i];
+    for (i = 1; i <= DimensionSaved; i++)
+        if (SucTour[T1[i - 1]] != T1[i])
+            d++;
+    return d;
+}
+
+/*
+ * SetNext lets the Next pointers represent tour T (as in
+ * MergeTourWithBestTour).
+ */
+
+static void SetNext(int *T)
+{
+    Node *N1, *N2, *M1, *M2;
+    int i;
+
+    for (i = 1; i <= DimensionSaved; i++) {
+        N1 = &NodeSet[T[i - 1]];
+        N2 = &NodeSet[T[i]];
+        M1 = &NodeSet[N1->Id + DimensionSaved];
+        M2 = &NodeSet[N2->Id + DimensionSaved];
+        M1->Next = N1;
+        N1->Next = M2;
+        M2->Next = N2;
+    }
+}
@@ -35,3 +35,17 @@ double GetTime()
 }
 
 #endif
+
+/*
+ * The GetWallTime function returns the elapsed (wall clock) time in
+ * seconds since some fixed point in the past.
+ */
+
+#include <sys/time.h>
+
+double GetWallTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
@@ -0,0 +1,310 @@
+#include "LKH.h"
+
+/*
+ * The HierarchicalInitialTour function computes an initial tour in two
+ * levels: first the order of the clusters (zones) is determined, then
+ * the nodes of each cluster are ordered.
+ *
+ * (1) The cluster order is found by solving a small ATSP on the clusters.
+ *     The cost of going from cluster A to cluster B is the minimum cost of
+ *     going from a node of A to a node of B. The objective of an order is
+ *     PENALTY_MULTIPLIER * penalty + cost, where the penalty is the zone
+ *     penalty of the order (see SequencePenalty). Starting from the order
+ *     of the tour constructed by ZoneInitialTour, the order is improved
+ *     by or-opt moves (a segment of one to three clusters is moved to
+ *     another position) until no improving move exists. The cluster of
+ *     the depot is kept as the first cluster.
+ *
+ * (2) For each pair of consecutive clusters, the exit node of the first
+ *     cluster and the entry node of the second are chosen as the nearest
+ *     pair of nodes, where the entry node of the depot's cluster is the
+ *     depot. The exit node of the last cluster is the node of the cluster
+ *     nearest to the depot. Each cluster is then traversed by a
+ *     Hamiltonian path from its entry node to its exit node, constructed
+ *     by the nearest neighbor heuristic and improved by or-opt moves.
+ *
+ * The resulting tour is subsequently polished by the Lin-Kernighan
+ * heuristic on the full instance.
+ *
+ * The function returns the cost of the tour. If the problem contains
+ * fixed edges (other than the edges of the ATSP transformation), the
+ * current tour is left unchanged, and LLONG_MAX is returned. LLONG_MAX
+ * is also returned if the clusters are not contiguous in the tour
+ * constructed by ZoneInitialTour. In both cases, the caller falls back
+ * to the default initial tour construction.
+ */
+
+#define Twin(N) (&NodeSet[(N)->Id + DimensionSaved])
+#define MaxSegment 3
+
+static Cluster **Sequence, **NewSequence;
+static long long **W;
+static Node **Path, **NewPath;
+
+static void FreeStructures(void);
+static long long Objective(Cluster ** Sequence);
+static void ImprovePath(int Size);
+static long long PathCost(Node ** Path, int Size);
+static Node *Traverse(Cluster * Cl, Node * Entry, Node * Exit,
+                      Node * Last);
+static long long TravelCost(Node * Na, Node * Nb);
+
+long long HierarchicalInitialTour()
+{
+    Node *N, *Na, *Nb, *Entry, *Exit, *NextEntry, *Last;
+    Cluster *Cl;
+    long long Cost, BestObjective, NewObjective;
+    int i, j, k, L, Count, Improved, MaxSize = 0;
+
+    if (ZoneInitialTour() == LLONG_MAX)
+        return LLONG_MAX;
+    Sequence = (Cluster **) malloc((GTSPSets + 1) * sizeof(Cluster *));
+    NewSequence = (Cluster **) malloc((GTSPSets + 1) * sizeof(Cluster *));
+    W = (long long **) malloc((GTSPSets + 1) * sizeof(long long *));
+    for (i = 1; i <= GTSPSets; i++) {
+        W[i] = (long long *) malloc((GTSPSets + 1) * sizeof(long long));
+        for (j = 1; j <= GTSPSets; j++)
+            W[i][j] = LLONG_MAX;
+    }
+
+    /* Compute the costs between the clusters */
+    for (i = 1; i <= DimensionSaved; i++) {
+        Na = &NodeSet[i];
+        for (j = 1; j <= DimensionSaved; j++) {
+            Nb = &NodeSet[j];
+            if (Na->MyCluster != Nb->MyCluster &&
+                (Cost = TravelCost(Na, Nb)) <
+                W[Na->MyCluster->Id][Nb->MyCluster->Id])
+                W[Na->MyCluster->Id][Nb->MyCluster->Id] = Cost;
+        }
+    }
+
+    /* Take the cluster order of the zone tour as the start order */
+    Count = 0;
+    N = Depot;
+    do {
+        if (Count == 0 || N->MyCluster != Sequence[Count]) {
+            if (Count == GTSPSets)
+                break;
+            Sequence[++Count] = N->MyCluster;
+        }
+        N = N->Suc->Suc;
+    } while (N != Depot);
+    if (N != Depot || Count != GTSPSets) {
+        /* The clusters are not contiguous */
+        FreeStructures();
+        return LLONG_MAX;
+    }
+
+    /* Improve the cluster order by or-opt moves */
+    BestObjective = Objective(Sequence);
+    do {
+        Improved = 0;
+        for (L = 1; L <= MaxSegment; L++) {
+            for (i = 2; i + L - 1 <= GTSPSets; i++) {
+                for (j = 1; j <= GTSPSets; j++) {
+                    if (j >= i - 1 && j <= i + L - 1)
+                        continue;
+                    /* Move Sequence[i..i+L-1] to follow Sequence[j] */
+                    for (k = 1, Count = 0; k <= GTSPSets; k++) {
+                        if (k >= i && k <= i + L - 1)
+                            continue;
+                        NewSequence[++Count] = Sequence[k];
+                        if (k == j) {
+                            memcpy(&NewSequence[Count + 1], &Sequence[i],
+                                   L * sizeof(Cluster *));
+                            Count += L;
+                        }
+                    }
+                    if ((NewObjective = Objective(NewSequence)) <
+                        BestObjective) {
+                        BestObjective = NewObjective;
+                        memcpy(Sequence, NewSequence,
+                               (GTSPSets + 1) * sizeof(Cluster *));
+                        Improved = 1;
+                    }
+                }
+            }
+        }
+    } while (Improved);
+
+    /* Traverse the clusters in this order */
+    for (Cl = FirstCluster; Cl; Cl = Cl->Next)
+        if (Cl->Size > MaxSize)
+            MaxSize = Cl->Size;
+    Path = (Node **) malloc(MaxSize * sizeof(Node *));
+    NewPath = (Node **) malloc(MaxSize * sizeof(Node *));
+    for (i = 1; i <= DimensionSaved; i++)
+        NodeSet[i].V = 0;
+    Entry = Last = Depot;
+    for (k = 1; k <= GTSPSets; k++) {
+        Cl = Sequence[k];
+        Exit = NextEntry = 0;
+        Cost = LLONG_MAX;
+        Na = Cl->First;
+        do {
+            if (Na == Entry && Cl->Size > 1)
+                continue;
+            if (k == GTSPSets) {
+                if (TravelCost(Na, Depot) < Cost) {
+                    Cost = TravelCost(Na, Depot);
+                    Exit = Na;
+                }
+                continue;
+            }
+            Nb = Sequence[k + 1]->First;
+            do {
+                if (TravelCost(Na, Nb) < Cost) {
+                    Cost = TravelCost(Na, Nb);
+                    Exit = Na;
+                    NextEntry = Nb;
+                }
+            } while ((Nb = Nb->NextInCluster) != Sequence[k + 1]->First);
+        } while ((Na = Na->NextInCluster) != Cl->First);
+        Last = Traverse(Cl, Entry, Exit, Last);
+        Entry = NextEntry;
+    }
+    Follow(Twin(Depot), Last);
+    FreeStructures();
+
+    Cost = 0;
+    N = FirstNode;
+    do
+        Cost += C(N, N->Suc) - N->Pi - N->Suc->Pi;
+    while ((N = N->Suc) != FirstNode);
+    return Cost / Precision;
+}
+
+static void FreeStructures()
+{
+    int i;
+
+    for (i = 1; i <= GTSPSets; i++)
+        free(W[i]);
+    free(W);
+    free(Sequence);
+    free(NewSequence);
+    free(Path);
+    free(NewPath);
+    Path = NewPath = 0;
+}
+
+/*
+ * The Objective function returns PENALTY_MULTIPLIER * penalty + cost of
+ * visiting the clusters in the order given by Sequence.
+ */
+
+static long long Objective(Cluster ** Sequence)
+{
+    long long Cost = W[Sequence[GTSPSets]->Id][Sequence[1]->Id];
+    int i;
+
+    for (i = 1; i < GTSPSets; i++)
+        Cost += W[Sequence[i]->Id][Sequence[i + 1]->Id];
+    return PenaltyMultiplier * SequencePenalty(Sequence) + Cost / Precision;
+}
+
+/*
+ * The Traverse function appends a Hamiltonian path through the nodes of
+ * cluster Cl, from node Entry to node Exit, to the partial tour ending
+ * at node Last (see Place in ZoneInitialTour.c). The function returns the
+ * last node of the path.
+ */
+
+static Node *Traverse(Cluster * Cl, Node * Entry, Node * Exit, Node * Last)
+{
+    Node *N, *Nearest;
+    long long Cost, MinCost;
+    int Size = 0, i;
+
+    /* Nearest neighbor path from Entry, ending at Exit */
+    Path[Size++] = Entry;
+    Entry->V = 1;
+    Exit->V = 1;
+    while (Size < Cl->Size - (Exit != Entry)) {
+        Nearest = 0;
+        MinCost = LLONG_MAX;
+        N = Cl->First;
+        do {
+            if (!N->V && (Cost = TravelCost(Path[Size - 1], N)) < MinCost) {
+                MinCost = Cost;
+                Nearest = N;
+            }
+        } while ((N = N->NextInCluster) != Cl->First);
+        Path[Size++] = Nearest;
+        Nearest->V = 1;
+    }
+    if (Exit != Entry)
+        Path[Size++] = Exit;
+    ImprovePath(Size);
+    for (i = 0; i < Size; i++) {
+        N = Path[i];
+        if (N != Depot) {
+            Follow(Twin(N), Last);
+            Follow(N, Twin(N));
+        }
+        Last = N;
+    }
+    return Last;
+}
+
+/*
+ * The ImprovePath function improves the path Path[0..Size-1] by or-opt
+ * moves, keeping its first and last node in place.
+ */
+
+static void ImprovePath(int Size)
+{
+    long long BestCost = PathCost(Path, Size), NewCost;
+    int i, j, k, L, Count, Improved;
+
+    do {
+        Improved = 0;
+        for (L = 1; L <= MaxSegment; L++) {
+            for (i = 1; i + L - 1 < Size - 1; i++) {
+                for (j = 0; j < Size - 1; j++) {
+                    if (j >= i - 1 && j <= i + L - 1)
+                        continue;
+                    /* Move Path[i..i+L-1] to follow Path[j] */
+                    for (k = 0, Count = 0; k < Size; k++) {
+                        if (k >= i && k <= i + L - 1)
+                            continue;
+                        NewPath[Count++] = Path[k];
+                        if (k == j) {
+                            memcpy(&NewPath[Count], &Path[i],
+                                   L * sizeof(Node *));
+                            Count += L;
+                        }
+                    }
+                    if ((NewCost = PathCost(NewPath, Size)) < BestCost) {
+                        BestCost = NewCost;
+                        memcpy(Path, NewPath, Size * sizeof(Node *));
+                        Improved = 1;
+                    }
+                }
+            }
+        }
+    } while (Improved);
+}
+
+static long long PathCost(Node ** Path, int Size)
+{
+    long long Cost = 0;
+    int i;
+
+    for (i = 1; i < Size; i++)
+        Cost += TravelCost(Path[i - 1], Path[i]);
+    return Cost;
+}
+
+/*
+ * The TravelCost function returns the cost of going from node Na to
+ * node Nb, where Na and Nb are original (not twin) nodes.
+ */
+
+static long long TravelCost(Node * Na, Node * Nb)
+{
+    Node *Tb = Twin(Nb);
+
+    return (long long) C(Na, Tb) - Na->Pi - Tb->Pi;
+}
@@ -0,0 +1,32 @@
+#ifndef _GENETIC_H
+#define _GENETIC_H
+
+/*
+ * This header specifies the interface for the genetic algorithm part of
+ * LKH (POPULATION_SIZE > 1).
+ *
+ * The population is kept sorted by fitness: individual 0 has the lowest
+ * penalty and, among the individuals with that penalty, the lowest cost.
+ */
+
+#define SmallerFitness(Penalty, Cost, i)\
+    ((Penalty) < PenaltyFitness[i] ||\
+     ((Penalty) == PenaltyFitness[i] && (Cost) < Fitness[i]))
+
+extern int MaxPopulationSize; /* The maximum size of the population */
+extern int PopulationSize;    /* The current size of the population */
+
+extern int **Population;      /* Array of individuals (solution tours) */
+extern long long *PenaltyFitness; /* The penalty of each individual */
+extern long long *Fitness;    /* The cost of each individual */
+extern unsigned *TourHash;    /* The hash value of each individual */
+
+void AddToPopulation(long long Penalty, long long Cost);
+void ApplyCrossover(int i, int j);
+int HasTour(long long Penalty, long long Cost);
+int LinearSelection(int Size, double Bias);
+void PrintPopulation(void);
+void ReplaceIndividualWithTour(int i, long long Penalty, long long Cost);
+int ReplacementIndividual(long long Penalty, long long Cost);
+
+#endif
@@ -36,9 +36,11 @@
 enum Types { TSPTW };
 enum EdgeWeightTypes { EXPLICIT };
 enum EdgeWeightFormats { FULL_MATRIX };
-enum CandidateSetTypes { ALPHA };
-enum InitialTourAlgorithms { WALK };
+enum CandidateSetTypes { ALPHA, NN };
+enum InitialTourAlgorithms { WALK, ZONE, HIERARCHICAL };
+enum MergeAlgorithms { IPT, GPX };
 enum ConstraintType { AND, OR };
+enum PruningTypes { NO_PRUNING, DEMOTE, DROP };
 
 typedef struct Node Node;
 typedef struct Candidate Candidate;
@@ -94,12 +96,24 @@ struct Node {
     Node *FixedTo1Saved, /* Saved values of FixedTo1 and FixedTo2 */
          *FixedTo2Saved;
     Node *SucSaved;             /* Saved pointer to successor node */
+    Node *InitialSuc;  /* Successor in the initial tour */
+    Node *MergeSuc;    /* Successor in the merge tour */
+    Node *BackboneSuc; /* Successor in all tours collected for the backbone */
+    Node *BackboneFixedTo; /* Opposite end node of a fixed backbone edge */
     Candidate *CandidateSet;    /* Candidate array */
     double ServiceTime;
     int DepotId;     /* Equal to Id if the node is a depot; otherwize 0 */
     double Earliest, Latest;
     Cluster *MyCluster;
     Node *NextInCluster;
+    double Lat, Lng;  /* Latitude and longitude of the node (in radians) */
+    double CosLat;    /* Cosine of Lat */
+    int *SparseId;    /* Sparse costs: Sorted Ids of the nodes to which
+                         (from which, for a twin node) costs are stored */
+    int *SparseCost;  /* The stored costs */
+    int SparseCount;  /* Number of stored costs */
+    int SparseMax;    /* Largest stored cost */
+    int SparseMean;   /* Mean of the costs that are not stored */
 };
 
 /* The Candidate structure is used to represent candidate edges */
@@ -136,14 +150,29 @@ struct ZoneConstraint {
     int Type;
 };
 
+/* The StatsRecord structure is used to accumulate the phase times
+   (in seconds of wall clock time) and the counters reported in
+   STATS_FILE */
+
+typedef struct StatsRecord {
+    double StartTime, ReadProblemTime, CTSPTransformTime, AscentTime,
+           GenerateCandidatesTime, TrialTime, MergeTime;
+    long long Trials, PenaltyCalls, SpecialMoveCandidates,
+              ThreeOptMoves, FourOptMoves, HashHits, Kicks, Merges;
+} StatsRecord;
+
 /* The SwapRecord structure is used to record 2-opt moves (swaps) */
 
 struct SwapRecord {
     Node *t1, *t2, *t3, *t4;    /* The 4 nodes involved in a 2-opt move */
 };
 
+extern int AdaptiveKicking; /* Specifies whether kicks are chosen
+                               adaptively */
 extern int AscentCandidates;   /* Number of candidate edges to be associated
                                   with each node during the ascent */
+extern int BackboneRuns; /* Number of runs whose tours determine the
+                           backbone */
 extern long long BestCost;      /* Cost of the tour in BestTour */
 extern long long BestPenalty;   /* Penalty of the tour in BestTour */
 extern int *BestTour;           /* Table containing best tour found */
@@ -151,6 +180,11 @@ extern long long BetterCost;    /* Cost of the tour stored in BetterTour */
 extern long long BetterPenalty; /* Penalty of the tour stored in BetterTour */
 extern int *BetterTour;         /* Table containing the currently best tour 
                                    in a run */
+extern int CandidateSetType; /* Specifies the type of the candidate set */
+extern int CandidateThreads; /* Number of threads used for creating the
+                                candidate set */
+extern double CheckpointInterval; /* Minimum time in seconds between two
+                                    checkpoints */
 extern int *CostMatrix;         /* Cost matrix */
 extern long long CurrentGain;
 extern long long CurrentPenalty;
@@ -158,6 +192,7 @@ extern Node *Depot;
 extern int Dimension;          /* Number of nodes in the problem */
 extern int DimensionSaved;     /* Saved value of Dimension */
 extern int Dim;                /* DimensionSaved - Salesmen + 1 */
+extern int ExactDimension;     /* Maximum dimension for solving exactly */
 extern double Excess;          /* Maximum alpha-value allowed for any 
                                   candidate edge is set to Excess times the 
                                   absolute value of the lower bound of a 
@@ -182,8 +217,15 @@ extern Node **Heap;    /* Heap used for computing minimum spanning trees */
 extern HashTable *HTable;      /* Hash table used for storing tours */
 extern int HashingUsed;        /* Specifies whether hashing is used */
 extern int InitialPeriod;      /* Length of the first period in the ascent */
+extern int InitialTourAlgorithm; /* Algorithm used for constructing the
+                                    initial tour */
+extern int IntraZoneOptimization; /* Specifies whether the nodes within
+                                     each cluster are reordered
+                                     optimally */
 extern int KickType;   /* Specifies K for a K-swap-kick */
 extern char *LastLine; /* Last input line */
+extern double LastImprovementTime; /* Time of the last improvement of
+                                      the best tour */
 extern double LowerBound;      /* Lower bound found by the ascent */
 extern int M;          /* The M-value is used when solving an ATSP-
                            instance by transforming it to a STSP-instance */
@@ -194,6 +236,12 @@ extern int MaxCandidates;      /* Maximum number of candidate edges to be
 extern int MaxMatrixDimension; /* Maximum dimension for an explicit
                                   cost matrix */
 extern int MaxTrials;  /* Maximum number of trials in each run */
+extern double MinImprovementRate; /* Minimum relative improvement of the
+                                     objective per second */
+extern double ImprovementRateWindow; /* Length in seconds of the period over
+                                        which the improvement rate is
+                                        measured */
+extern int MergeAlgorithm;     /* Algorithm used for merging tours */
 extern int MergingUsed;        /* Specifies whether merging is used */
 extern int MoveType;   /* Specifies the sequantial move type to be used 
                           in local search. A value K >= 2 signifies 
@@ -212,13 +260,28 @@ extern short Reversed; /* Boolean used to indicate whether a tour has
 extern int Run;        /* Current run number */
 extern int Runs;       /* Total number of runs */
 extern unsigned Seed;  /* Initial seed for random number generation */
+extern int SparseNeighbors; /* Number of nearest successors and predecessors
+                               of each node whose costs are stored
+                               (0: all costs are stored) */
+extern double SparseScale;  /* Travel time per meter used for estimating
+                               the costs that are not stored */
+extern double StagnationTime; /* Maximum time in seconds without
+                                 improvement of the best tour */
+extern int StagnationTrials;  /* Maximum number of trials without
+                                 improvement of the best tour */
 extern double ServiceTime;     /* Service time for a CVRP instance */
 extern double StartTime;       /* Time when execution starts */
 extern int Subgradient;        /* Specifies whether the Pi-values should be 
                                   determined by subgradient optimization */
+extern StatsRecord Stats;     /* Phase times and counters */
+extern char *StatsFileName;   /* Name of the file for statistics */
 extern SwapRecord *SwapStack;  /* Stack of SwapRecords */
 extern int Swaps;      /* Number of swaps made during a tentative move */
+extern double TimeExtension; /* Maximum extension of the time limit 
+                                in seconds */
 extern double TimeLimit;    /* The time limit in seconds */
+extern int TimeWindowPruning; /* Specifies how candidate edges violating
+                                 time windows are pruned */
 extern int TimeWindowsUsed;  /* Specifies whether time window are used */
 extern int TraceLevel; /* Specifies the level of detail of the output 
                           given during the solution process. 
@@ -226,6 +289,10 @@ extern int TraceLevel; /* Specifies the level of detail of the output
                           output. The higher the value is the more 
                           information is given */
 extern int Trial;      /* Ordinal number of the current trial */
+extern int ZonePruning; /* Specifies how candidate edges violating zone
+                           precedences are pruned */
+extern int ZoneKick;   /* Specifies whether kicks only cut the tour at
+                          zone boundaries */
 
 extern ZoneConstraint *FirstZoneNeighborConstraint;
 extern ZoneConstraint *FirstZonePathConstraint;
@@ -243,18 +310,21 @@ extern ZoneConstraint *FirstSuperSuperZonePrecedenceConstraint;
    ReadProblem: */
 
 extern char *ParameterFileName, *ProblemFileName, *InitialTourFileName,
-            *TourFileName;
+            *MergeTourFileName, *TourFileName, *CheckpointFileName,
+            *ConvergenceFileName;
 extern char *Name, *Type, *EdgeWeightType, *EdgeWeightFormat;
 extern int CandidateSetSymmetric, MTSPDepot,
            ProblemType, WeightType, WeightFormat;
 
-extern FILE *ParameterFile, *ProblemFile, *InitialTourFile;
+extern FILE *ParameterFile, *ProblemFile, *InitialTourFile,
+            *MergeTourFile;
 extern CostFunction Distance, D, C, c, OldDistance;
 
 /* Function prototypes: */
 
 int Distance_ATSP(Node * Na, Node * Nb);
 int Distance_EXPLICIT(Node * Na, Node * Nb);
+int Distance_SPARSE(Node * Na, Node * Nb);
 
 int D_EXPLICIT(Node * Na, Node * Nb);
 int D_FUNCTION(Node * Na, Node * Nb);
@@ -264,16 +334,21 @@ int C_FUNCTION(Node * Na, Node * Nb);
 
 void Activate(Node * t);
 int AddCandidate(Node * From, Node * To, int Cost, int Alpha);
+int AdaptiveKick(void);
+void AdaptiveKickReward(long long Penalty, long long Cost);
 void AddTourCandidates(void);
 void AdjustCandidateSet(void);
 void AllocateStructures(void);
 long long Ascent(void);
+long long BackboneCost(void);
 int Between(const Node * ta, const Node * tb, const Node * tc);
 int Between_SL(const Node * ta, const Node * tb, const Node * tc);
 void ChooseInitialTour(void);
 void Connect(Node * N1, int Max, int Sparse);
 void CandidateReport(void);
 void CreateCandidateSet(void);
+void CreateNearestNeighborCandidateSet(int MaxCandidates);
+int DominatesInputTours(long long Penalty, long long Cost);
 void eprintf(const char *fmt, ...);
 int FixedCandidates(Node * N);
 long long FindTour(void);
@@ -284,6 +359,9 @@ char *FullName(char * Name, long long Cost);
 int fscanint(FILE *f, int *v);
 void GenerateCandidates(int MaxCandidates, long long MaxAlpha, int Symmetric);
 double GetTime(void);
+double GetWallTime(void);
+double GreatCircleDistance(Node * Na, Node * Nb);
+long long HierarchicalInitialTour(void);
 int Improvement(long long  * Gain, Node * t1, Node * SUCt1);
 void InitializeStatistics(void);
 int IsCandidate(const Node * ta, const Node * tb);
@@ -293,30 +371,48 @@ void KSwapKick(int K);
 long long LinKernighan(void);
 long long MergeTourWithBestTour(void);
 long long MergeWithTour(void);
+long long MergeWithTourGPX(void);
 long long Minimum1TreeCost(int Sparse);
 void MinimumSpanningTree(int Sparse);
 void NormalizeNodeList(void);
+long long OptimizeZonePaths(void);
 long long Penalty(void);
-long long TotalTWViolation(int *num_violation);
+long long TotalTWViolation(int *Tour, int *num_violation);
+int Preempted(void);
 void PrepareKicking(void);
 void printff(const char * fmt, ...);
 void PrintParameters(void);
 void PrintStatistics(void);
+int PruneCandidates(int (*Infeasible) (Node * Na, Node * Nb), int Type);
+void PruneTimeWindowCandidates(void);
+void PruneZoneCandidates(void);
 unsigned Random(void);
 char *ReadLine(FILE * InputFile);
 void ReadParameters(void);
 void ReadProblem(void);
 void ReadTour(char * FileName, FILE ** File);
+int RecombineTours(void);
 void RecordBestTour(void);
 void RecordBetterTour(void);
+void RecordProgress(long long Penalty, long long Cost, int Trials);
 Node *RemoveFirstActive(void);
 void RestoreTour(void);
+long long SequencePenalty(Cluster ** Sequence);
+long long SolveExactly(void);
+int Stagnated(void);
 void SpecialMove(Node * t1, Node * t2, long long * G0, long long * Gain);
 void StatusReport(long long Cost, double EntryTime, char * Suffix);
 void StoreTour(void);
 void SRandom(unsigned seed);
 void SymmetrizeCandidateSet(void);
+int TimeLimitExceeded(void);
+void UpdateBackbone(void);
 void UpdateStatistics(long long Cost, double Time);
+void WriteCheckpoint(int * Tour, long long Objective, long long Cost);
+void WriteConvergence(char Type, long long Penalty, long long Cost);
+void WriteStatistics(char * FileName);
 void WriteTour(char * FileName, int * Tour, long long Cost);
+long long ZoneInitialTour(void);
+void ZoneKSwapKick(int K);
 
 #endif
@@ -28,6 +28,7 @@ void KSwapKick(int K)
     Node **s, *N;
     int i;
 
+    Stats.Kicks++;
     s = (Node **) malloc(K * sizeof(Node *));
     N = FirstNode = s[0] = LongEdgeNode();
     if (!N)
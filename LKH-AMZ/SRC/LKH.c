@@ -4,8 +4,11 @@
  * All global variables of the program.
  */
 
+int AdaptiveKicking; /* Specifies whether kicks are chosen adaptively */
 int AscentCandidates;   /* Number of candidate edges to be associated
                            with each node during the ascent */
+int BackboneRuns; /* Number of runs whose tours determine the
+                    backbone */
 long long BestCost;      /* Cost of the tour in BestTour */
 long long BestPenalty;   /* Penalty of the tour in BestTour */
 int *BestTour;          /* Table containing best tour found */
@@ -13,7 +16,12 @@ long long BetterCost;    /* Cost of the tour stored in BetterTour */
 long long BetterPenalty; /* Penalty of the tour stored in BetterTour */
 int *BetterTour;        /* Table containing the currently best tour 
                            in a run */
+int CandidateSetType; /* Specifies the type of the candidate set */
+int CandidateThreads; /* Number of threads used for creating the
+                         candidate set */
 int CacheMask;  /* Mask for indexing the cache */
+double CheckpointInterval; /* Minimum time in seconds between two 
+                              checkpoints */
 int *CacheVal;  /* Table of cached distances */
 int *CacheSig;  /* Table of the signatures of cached 
                    distances */
@@ -24,6 +32,7 @@ Node *Depot;
 int Dimension;          /* Number of nodes in the problem */
 int DimensionSaved;     /* Saved value of Dimension */
 int Dim;                /* DimensionSaved - Salesmen + 1 */
+int ExactDimension;     /* Maximum dimension for solving exactly */
 double Excess;          /* Maximum alpha-value allowed for any 
                            candidate edge is set to Excess times the 
                            absolute value of the lower bound of a 
@@ -43,8 +52,14 @@ int HashingUsed; /* Specifies whether hashing is used */
 Node **Heap;    /* Heap used for computing minimum spanning trees */
 HashTable *HTable;      /* Hash table used for storing tours */
 int InitialPeriod;      /* Length of the first period in the ascent */
+int InitialTourAlgorithm; /* Algorithm used for constructing the
+                             initial tour */
+int IntraZoneOptimization; /* Specifies whether the nodes within each
+                              cluster are reordered optimally */
 int KickType;   /* Specifies K for a K-swap-kick */
 char *LastLine; /* Last input line */
+double LastImprovementTime; /* Time of the last improvement of 
+                               the best tour */
 double LowerBound;      /* Lower bound found by the ascent */
 int M;          /* The M-value is used when solving an ATSP-
                    instance by transforming it to a STSP-instance */
@@ -54,6 +69,11 @@ int MaxCandidates;      /* Maximum number of candidate edges to be
                            associated with each node */
 int MaxMatrixDimension; /* Maximum dimension for an explicit cost matrix */
 int MaxTrials;  /* Maximum number of trials in each run */
+double MinImprovementRate; /* Minimum relative improvement of the
+                              objective per second */
+double ImprovementRateWindow; /* Length in seconds of the period over
+                                 which the improvement rate is measured */
+int MergeAlgorithm;     /* Algorithm used for merging tours */
 int MergingUsed;        /* Specifies whether merging is used */
 int MoveType;   /* Specifies the sequantial move type to be used 
                    in local search. A value K >= 2 signifies 
@@ -72,13 +92,28 @@ short Reversed; /* Boolean used to indicate whether a tour has
 int Run;        /* Current run number */
 int Runs;       /* Total number of runs */
 unsigned Seed;  /* Initial seed for random number generation */
+int SparseNeighbors; /* Number of nearest successors and predecessors of
+                        each node whose costs are stored
+                        (0: all costs are stored) */
+double SparseScale;  /* Travel time per meter used for estimating the
+                        costs that are not stored */
+double StagnationTime; /* Maximum time in seconds without improvement
+                          of the best tour */
+int StagnationTrials;  /* Maximum number of trials without improvement
+                          of the best tour */
 double ServiceTime;     /* Service time for a CVRP instance */
 double StartTime;       /* Time when execution starts */
 int Subgradient;        /* Specifies whether the Pi-values should be 
                            determined by subgradient optimization */
+StatsRecord Stats;     /* Phase times and counters */
+char *StatsFileName;   /* Name of the file for statistics */
 SwapRecord *SwapStack;  /* Stack of SwapRecords */
 int Swaps;      /* Number of swaps made during a tentative move */
+double TimeExtension; /* Maximum extension of the time limit 
+                         in seconds */
 double TimeLimit;    /* The time limit in seconds */
+int TimeWindowPruning; /* Specifies how candidate edges violating time
+                          windows are pruned */
 int TimeWindowsUsed; /* Specifies whether time windows are used */
 int TraceLevel; /* Specifies the level of detail of the output 
                    given during the solution process. 
@@ -86,6 +121,10 @@ int TraceLevel; /* Specifies the level of detail of the output
                    output. The higher the value is the more 
                    information is given */
 int Trial;      /* Ordinal number of the current trial */
+int ZonePruning; /* Specifies how candidate edges violating zone
+                    precedences are pruned */
+int ZoneKick;   /* Specifies whether kicks only cut the tour at
+                   zone boundaries */
 
 ZoneConstraint *FirstZoneNeighborConstraint;
 ZoneConstraint *FirstZonePathConstraint;
@@ -103,10 +142,11 @@ ZoneConstraint *FirstSuperSuperZonePrecedenceConstraint;
    ReadProblem: */
 
 char *ParameterFileName, *ProblemFileName, *InitialTourFileName,
-     *PiFileName, *TourFileName;
+     *MergeTourFileName, *PiFileName, *TourFileName, *CheckpointFileName,
+     *ConvergenceFileName;
 char *Name, *Type, *EdgeWeightType, *EdgeWeightFormat;
 int CandidateSetSymmetric, MTSPDepot,
     ProblemType, WeightType, WeightFormat;
 
-FILE *ParameterFile, *ProblemFile, *InitialTourFile;
+FILE *ParameterFile, *ProblemFile, *InitialTourFile, *MergeTourFile;
 CostFunction Distance, D, C, c, OldDistance;
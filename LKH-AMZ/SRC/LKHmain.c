@@ -1,4 +1,5 @@
 #include "LKH.h"
+#include "Genetic.h"
 
 /*
  * This file contains the main function of the program.
@@ -6,22 +7,27 @@
 
 int main(int argc, char *argv[])
 {
-    long long Cost;
-    double Time, LastTime;
+    long long Cost, RunPenalty;
+    double Time, LastTime, WallTime;
 
     /* Read the specification of the problem */
     if (argc >= 2)
         ParameterFileName = argv[1];
     ReadParameters();
     StartTime = LastTime = GetTime();
+    Stats.StartTime = GetWallTime();
     MaxMatrixDimension = 20000;
+    WallTime = GetWallTime();
     ReadProblem();
+    Stats.ReadProblemTime = GetWallTime() - WallTime;
+    WallTime = GetWallTime();
     if (CTSPTransform && GTSPSets > 1) {
         /* CTSP transform */
         int i, j;
         Node *From, *To;
         MM = INT_MAX / GTSPSets / Precision;
-        for (i = 1; i <= DimensionSaved; i++) {
+        /* With sparse costs, MM is added by Distance_SPARSE */
+        for (i = 1; CostMatrix && i <= DimensionSaved; i++) {
             From = &NodeSet[i];
             for (j = 1; j <= DimensionSaved; j++) {
                 if (i == j)
@@ -32,23 +38,49 @@ int main(int argc, char *argv[])
             }
         }
     }
+    Stats.CTSPTransformTime = GetWallTime() - WallTime;
     AllocateStructures();
-    CreateCandidateSet();
     InitializeStatistics();
 
-    if (Norm != 0) {
-        Norm = 9999;
-        BestCost = LLONG_MAX;
-        BestPenalty = CurrentPenalty = LLONG_MAX;
-    } else {
-        /* The ascent has solved the problem! */
-        BestCost = LowerBound - GTSPSets * MM;
+    if (DimensionSaved <= ExactDimension &&
+        (Cost = SolveExactly()) != LLONG_MAX) {
+        /* The problem has been solved exactly */
+        BestCost = Cost - GTSPSets * MM;
         UpdateStatistics(BestCost, GetTime() - LastTime);
         RecordBetterTour();
         RecordBestTour();
-        CurrentPenalty = LLONG_MAX;
-        BestPenalty = PenaltyMultiplier * Penalty() + BestCost;
-        WriteTour(TourFileName, BestTour, BestCost);
+        BestPenalty = PenaltyMultiplier * CurrentPenalty + BestCost;
+        WriteConvergence('G', CurrentPenalty, BestCost);
+        Runs = 0;
+    } else {
+        CreateCandidateSet();
+        if (Norm != 0) {
+            Norm = 9999;
+            BestCost = LLONG_MAX;
+            BestPenalty = CurrentPenalty = LLONG_MAX;
+        } else {
+            /* The ascent has solved the problem! */
+            BestCost = LowerBound - GTSPSets * MM;
+            UpdateStatistics(BestCost, GetTime() - LastTime);
+            RecordBetterTour();
+            RecordBestTour();
+            CurrentPenalty = LLONG_MAX;
+            CurrentPenalty = Penalty();
+            BestPenalty = PenaltyMultiplier * CurrentPenalty + BestCost;
+            WriteConvergence('G', CurrentPenalty, BestCost);
+            Runs = 0;
+        }
+    }
+
+    if (MergeTourFileName) {
+        /* Recombine the initial tour with the merge tour. If the problem
+           has already been solved, just check that the solution dominates
+           both tours */
+        WallTime = GetWallTime();
+        if (Runs > 0 ? !RecombineTours() :
+            !DominatesInputTours(CurrentPenalty, BestCost))
+            TourFileName = 0;
+        Stats.MergeTime += GetWallTime() - WallTime;
         Runs = 0;
     }
 
@@ -56,23 +88,63 @@ int main(int argc, char *argv[])
 
     for (Run = 1; Run <= Runs; Run++) {
         LastTime = GetTime();
-        if (Run > 1 && LastTime - StartTime >= TimeLimit) {
+        if (Run > 1 && TimeLimitExceeded()) {
             if (TraceLevel >= 1)
                 printff("*** Time limit exceeded ***\n");
             break;
         }
+        if (Run > 1 && Stagnated())
+            break;
+        if (MaxPopulationSize > 1 && PopulationSize >= 2 &&
+            (PopulationSize == MaxPopulationSize ||
+             Run > 2 * MaxPopulationSize)) {
+            /* Start from the offspring of two individuals */
+            int Parent1, Parent2;
+            WallTime = GetWallTime();
+            Parent1 = LinearSelection(PopulationSize, 1.25);
+            do
+                Parent2 = LinearSelection(PopulationSize, 1.25);
+            while (Parent2 == Parent1);
+            ApplyCrossover(Parent1, Parent2);
+            Stats.MergeTime += GetWallTime() - WallTime;
+        }
+        WallTime = GetWallTime();
         Cost = FindTour();    /* using the Lin-Kernighan heuristic */
-        if (MergingUsed && Run > 1 && Cost != BestCost - GTSPSets * MM)
+        if (IntraZoneOptimization && Cost != LLONG_MAX)
+            Cost = OptimizeZonePaths();
+        Stats.TrialTime += GetWallTime() - WallTime;
+        if (MaxPopulationSize <= 1 && MergingUsed && Run > 1 &&
+            Cost != BestCost - GTSPSets * MM) {
+            WallTime = GetWallTime();
             Cost = MergeTourWithBestTour();
+            Stats.MergeTime += GetWallTime() - WallTime;
+        }
         Cost -= GTSPSets * MM;
+        if (MaxPopulationSize > 1 && !HasTour(CurrentPenalty, Cost)) {
+            /* Add the tour to the population, or replace a worse one */
+            if (PopulationSize < MaxPopulationSize)
+                AddToPopulation(CurrentPenalty, Cost);
+            else if (SmallerFitness(CurrentPenalty, Cost, PopulationSize - 1))
+                ReplaceIndividualWithTour(ReplacementIndividual
+                                          (CurrentPenalty, Cost),
+                                          CurrentPenalty, Cost);
+            if (TraceLevel >= 2)
+                PrintPopulation();
+        }
+        RecordProgress(RunPenalty = CurrentPenalty, Cost, 0);
         CurrentPenalty = PenaltyMultiplier * CurrentPenalty + Cost;
         if (CurrentPenalty < BestPenalty ||
             (CurrentPenalty == BestPenalty && Cost < BestCost)) {
             BestPenalty = CurrentPenalty;
             BestCost = Cost;
+            WriteConvergence('G', RunPenalty, Cost);
             RecordBetterTour();
             RecordBestTour();
+            WriteCheckpoint(BestTour, BestPenalty, BestCost);
         }
+        WriteCheckpoint(0, 0, 0);
+        if (BackboneRuns > 0)
+            UpdateBackbone();
         Time = fabs(GetTime() - LastTime);
         UpdateStatistics(Cost, Time);
         if (TraceLevel >= 1 && Cost != LLONG_MAX) {
@@ -84,6 +156,7 @@ int main(int argc, char *argv[])
     }
     CurrentPenalty = BestPenalty;
     WriteTour(TourFileName, BestTour, BestCost);
+    WriteStatistics(StatsFileName);
     if (TraceLevel >= 1)
         PrintStatistics();
     if (1) {
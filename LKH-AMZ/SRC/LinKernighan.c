@@ -6,7 +6,12 @@
  * The LinKernighan function seeks to improve a tour by sequential
  * and non-sequential edge exchanges.
  *
- * The function returns the cost of the resulting tour.
+ * The function returns the cost of the resulting tour. The cost
+ * includes the distances of the fixed backbone edges of the tour (see
+ * BackboneCost).
+ *
+ * The time limit is checked for every 16 nodes chosen as t1. If it has
+ * been reached, the function returns immediately with the current tour.
  */
 
 long long LinKernighan()
@@ -44,7 +49,7 @@ long long LinKernighan()
             Activate(t1);
     }
     while ((t1 = t1->Suc) != FirstNode);
-    Cost /= Precision;
+    Cost = Cost / Precision + BackboneCost();
     CurrentPenalty = LLONG_MAX;
     CurrentPenalty = Penalty();
     if (TraceLevel >= 3 ||
@@ -57,8 +62,10 @@ long long LinKernighan()
     while ((t1 = RemoveFirstActive())) {
         /* t1 is now "passive" */
         SUCt1 = SUC(t1);
+        if ((++it & 15) == 0 && Preempted())
+            goto End_LinKernighan;
         if ((TraceLevel >= 3 || (TraceLevel == 2 && Trial == 1)) &&
-            ++it % (Dimension >= 100000 ? 10000 :
+            it % (Dimension >= 100000 ? 10000 :
                     Dimension >= 10000 ? 1000 : 100) == 0)
             printff("#%d: Time = %0.2f sec.\n",
                     it, fabs(GetTime() - EntryTime));
@@ -86,8 +93,10 @@ long long LinKernighan()
                       (CurrentPenalty == BetterPenalty &&
                        Cost < BetterCost))))
                     StatusReport(Cost, EntryTime, "");
-                if (HashingUsed && HashSearch(HTable, Hash, Cost))
+                if (HashingUsed && HashSearch(HTable, Hash, Cost)) {
+                    Stats.HashHits++;
                     goto End_LinKernighan;
+                }
                 /* Make t1 "active" again */
                 Activate(t1);
                 break;
@@ -98,5 +107,15 @@ long long LinKernighan()
   End_LinKernighan:
     NormalizeNodeList();
     Reversed = 0;
+    if (BackboneRuns > 0) {
+        /* A move may have added a fixed backbone edge, which has
+           distance 0. Recompute the cost of the tour */
+        Cost = 0;
+        t1 = FirstNode;
+        do
+            Cost += C(t1, t1->Suc) - t1->Pi - t1->Suc->Pi;
+        while ((t1 = t1->Suc) != FirstNode);
+        Cost = Cost / Precision + BackboneCost();
+    }
     return Cost;
 }
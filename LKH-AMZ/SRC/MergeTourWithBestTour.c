@@ -6,6 +6,11 @@
  * 
  * If a tour shorter than BestTour is found, Pred and Suc of each 
  * node point to its neighbors, and the tour cost is returned.
+ * The cost includes the distances of the fixed backbone edges of the
+ * tour (see BackboneCost).
+ *
+ * The merging is done by MergeWithTour or MergeWithTourGPX, depending on
+ * the value of MERGE_ALGORITHM.
  */
 
 long long MergeTourWithBestTour()
@@ -22,5 +27,6 @@ long long MergeTourWithBestTour()
         N1->Next = M2;
         M2->Next = N2;
     }
-    return MergeWithTour();
+    return (MergeAlgorithm == GPX ? MergeWithTourGPX() : MergeWithTour()) +
+        BackboneCost();
 }
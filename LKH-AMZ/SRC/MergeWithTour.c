@@ -37,6 +37,7 @@ long long  MergeWithTour()
     Node *N, *NNext, *N1, *N2, *MinN1, *MinN2, *First = 0, *Last;
     long long Penalty1 = 0, Penalty2 = 0, NewPenalty;
 
+    Stats.Merges++;
     CurrentPenalty = LLONG_MAX;
     Penalty1 = Penalty();
     N = FirstNode;
@@ -0,0 +1,306 @@
+#include "LKH.h"
+
+/*
+ * The MergeWithTourGPX function attempts to find a short tour by merging
+ * a given tour, T1, with another tour, T2, using generalized partition
+ * crossover (GPX). T1 is given by the Suc pointers of its nodes. T2 is
+ * given by the Next pointers of its nodes.
+ *
+ * The algorithm may be described as follows. Remove the edges common to
+ * T1 and T2 from the union graph of the two tours. The connected
+ * components of the remaining graph are found by a depth-first search.
+ * Only common edges connect different components. If exactly two common
+ * edges connect a component with the rest of the graph, both tours
+ * traverse the component as a single path between the same two end
+ * nodes. Thus, the path of one tour may be replaced by the path of the
+ * other tour. The offspring is constructed from the better of the two
+ * tours (with respect to penalty and cost) by taking the cheaper path
+ * through each such component. Components that are entered more than
+ * once are first fused, in the order they are met in T1, with the
+ * following components and the paths of common edges between them,
+ * until the fused component is entered only once. All this takes almost
+ * linear time in the number of nodes.
+ *
+ * Since the penalty depends on the whole tour, the penalty of the
+ * offspring is computed. If it exceeds that of the better tour, the
+ * components are instead tried one at a time, and a component is only
+ * taken from the other tour if this does not increase the penalty.
+ *
+ * The doubled nodes of an asymmetric problem need no special treatment:
+ * the edges between a node and its twin are fixed, and hence common to
+ * T1 and T2, and the orientation of every other edge follows from its
+ * end nodes.
+ *
+ * If a tour better than both T1 and T2 is found, Pred and Suc of each
+ * node point to its neighbors in this tour, and its cost is returned.
+ * Otherwise, T1 is kept, and its cost is returned.
+ *
+ * The algorithm is described in the paper
+ *
+ *   R. Tinos, D. Whitley, and G. Ochoa,
+ *   "A New Generalized Partition Crossover for the Traveling Salesman
+ *   Problem: Tunneling between Local Optima",
+ *   Evolutionary Computation, Volume 28, Number 2, pp. 255-288, 2020.
+ */
+
+typedef struct Component {
+    int Size;                 /* Number of nodes */
+    int Entries;              /* Number of common edges leaving the
+                                 component */
+    int Root;                 /* Parent in the union-find forest */
+    int FromT2;               /* Is the path of T2 used? */
+    Node *First;              /* First node in the list of nodes of the
+                                 component (linked by Mark) */
+    long long Cost1, Cost2;   /* Cost of the paths of T1 and T2 */
+} Component;
+
+static Component *Comp = 0;
+static int BuildOffspring(void);
+static int Find(int k);
+static void Fuse(int G, int k);
+
+#define InT1(Na, Nb) ((Nb) == (Na)->OldSuc || (Nb) == (Na)->OldPred)
+#define InT2(Na, Nb) ((Nb) == (Na)->Next || (Nb) == (Na)->Prev)
+
+long long MergeWithTourGPX()
+{
+    Node *N, *M, *Stack, *Neighbor[4], *PathStart = 0;
+    long long Cost1 = 0, Cost2 = 0, Cost, BaseCost, BasePenalty;
+    long long Penalty1, Penalty2, NewPenalty, P, Gain;
+    int Components = 0, Candidates = 0, G = 0, i, k, Base2;
+
+    Stats.Merges++;
+    if (!Comp)
+        Comp = (Component *) malloc((Dimension + 1) * sizeof(Component));
+    CurrentPenalty = LLONG_MAX;
+    Penalty1 = Penalty();
+    N = FirstNode;
+    do {
+        (N->OldSuc = N->Suc)->OldPred = N->Next->Prev = N;
+        N->Rank = 0;
+        Cost1 += N->Cost = C(N, N->Suc) - N->Pi - N->Suc->Pi;
+        Cost2 += N->NextCost = C(N, N->Next) - N->Pi - N->Next->Pi;
+    } while ((N = N->Suc) != FirstNode);
+
+    /* Label the components of the graph of uncommon edges */
+    do {
+        if (N->Rank)
+            continue;
+        Comp[++Components].Size = 1;
+        Comp[Components].Entries = 0;
+        Comp[Components].Root = Components;
+        Comp[Components].First = 0;
+        N->Rank = Components;
+        N->Mark = 0;
+        Stack = N;
+        while (Stack) {
+            M = Stack;
+            Stack = M->Mark;
+            M->Mark = Comp[Components].First;
+            Comp[Components].First = M;
+            Neighbor[0] = M->OldSuc;
+            Neighbor[1] = M->OldPred;
+            Neighbor[2] = M->Next;
+            Neighbor[3] = M->Prev;
+            for (i = 0; i < 4; i++) {
+                if (Neighbor[i]->Rank ||
+                    (i < 2 ? InT2(M, Neighbor[i]) : InT1(M, Neighbor[i])))
+                    continue;
+                Neighbor[i]->Rank = Components;
+                Comp[Components].Size++;
+                Neighbor[i]->Mark = Stack;
+                Stack = Neighbor[i];
+            }
+        }
+    } while ((N = N->Next) != FirstNode);
+
+    /* Count the entries of each component */
+    do
+        if (N->OldSuc->Rank != N->Rank) {
+            Comp[N->Rank].Entries++;
+            Comp[N->OldSuc->Rank].Entries++;
+        }
+    while ((N = N->OldSuc) != FirstNode);
+
+    /* Fuse the components that are entered more than once, together with
+       the paths of common edges between them, in the order they are met
+       in T1. A group of fused components is closed as soon as it is
+       entered only once */
+    do {
+        k = Find(N->Rank);
+        if (k == G || (G && Comp[k].Size == 1)) {
+            if (k != G && !PathStart)
+                PathStart = N;
+            else if (k == G) {
+                for (M = PathStart; M && M != N; M = M->OldSuc)
+                    Fuse(G, M->Rank);
+                PathStart = 0;
+            }
+        } else if (Comp[k].Entries == 2)
+            G = 0;
+        else if (Comp[k].Size > 1) {
+            if (G) {
+                for (M = PathStart; M && M != N; M = M->OldSuc)
+                    Fuse(G, M->Rank);
+                Fuse(G, k);
+            } else
+                G = k;
+            PathStart = 0;
+        }
+        if (G && Comp[G].Entries == 2) {
+            G = 0;
+            PathStart = 0;
+        }
+    } while ((N = N->OldSuc) != FirstNode);
+
+    /* Count the entries of each (fused) component, and cost its paths */
+    for (k = 1; k <= Components; k++) {
+        Comp[k].Entries = 0;
+        Comp[k].Cost1 = Comp[k].Cost2 = 0;
+    }
+    do {
+        k = N->Rank = Find(N->Rank);
+        M = N->OldSuc;
+        if (Find(M->Rank) != k) {
+            Comp[k].Entries++;
+            Comp[Find(M->Rank)].Entries++;
+        } else
+            Comp[k].Cost1 += N->Cost;
+        if (Find(N->Next->Rank) == k)
+            Comp[k].Cost2 += N->NextCost;
+    } while ((N = N->OldSuc) != FirstNode);
+    for (k = 1; k <= Components; k++)
+        if (Comp[k].Root == k && Comp[k].Entries == 2 &&
+            Comp[k].Cost1 != Comp[k].Cost2)
+            break;
+    if (k > Components)
+        goto Reject;
+
+    /* Choose the better tour as base, and the cheaper path through
+       each component that is entered only once */
+    do
+        (N->Suc = N->Next)->Pred = N;
+    while ((N = N->Suc) != FirstNode);
+    CurrentPenalty = LLONG_MAX;
+    Penalty2 = Penalty();
+    Base2 = Penalty2 < Penalty1 || (Penalty2 == Penalty1 && Cost2 < Cost1);
+    BasePenalty = Base2 ? Penalty2 : Penalty1;
+    BaseCost = Cost = Base2 ? Cost2 : Cost1;
+    for (k = 1; k <= Components; k++) {
+        Comp[k].FromT2 = Base2;
+        if (Comp[k].Root != k || Comp[k].Entries != 2)
+            continue;
+        Gain = Base2 ? Comp[k].Cost2 - Comp[k].Cost1 :
+            Comp[k].Cost1 - Comp[k].Cost2;
+        if (Gain > 0) {
+            Comp[k].FromT2 = !Base2;
+            Cost -= Gain;
+            Candidates++;
+        }
+    }
+    if (Candidates == 0)
+        goto Reject;
+    CurrentPenalty = BasePenalty;
+    if (!BuildOffspring() || (NewPenalty = Penalty()) > BasePenalty) {
+        if (Candidates == 1)
+            goto Reject;
+        /* Try the components one at a time */
+        Cost = BaseCost;
+        NewPenalty = BasePenalty;
+        for (k = 1; k <= Components; k++)
+            Comp[k].FromT2 = Base2;
+        for (k = 1; k <= Components; k++) {
+            if (Comp[k].Root != k || Comp[k].Entries != 2)
+                continue;
+            Gain = Base2 ? Comp[k].Cost2 - Comp[k].Cost1 :
+                Comp[k].Cost1 - Comp[k].Cost2;
+            if (Gain <= 0)
+                continue;
+            Comp[k].FromT2 = !Base2;
+            CurrentPenalty = NewPenalty;
+            if (BuildOffspring() && (P = Penalty()) <= NewPenalty) {
+                NewPenalty = P;
+                Cost -= Gain;
+            } else
+                Comp[k].FromT2 = Base2;
+        }
+        if (Cost == BaseCost)
+            goto Reject;
+        BuildOffspring();
+    }
+    CurrentPenalty = NewPenalty;
+    if (HashingUsed) {
+        Hash = 0;
+        N = FirstNode;
+        do
+            Hash ^= Rand[N->Id] * Rand[N->Suc->Id];
+        while ((N = N->Suc) != FirstNode);
+    }
+    if (TraceLevel >= 2)
+        printff("GPX: %lld_%lld\n", CurrentPenalty, Cost / Precision);
+    return Cost / Precision;
+
+Reject:
+    N = FirstNode;
+    do {
+        N->Suc = N->OldSuc;
+        N->Pred = N->OldPred;
+    } while ((N = N->Suc) != FirstNode);
+    CurrentPenalty = Penalty1;
+    return Cost1 / Precision;
+}
+
+/*
+ * The BuildOffspring function lets the Suc and Pred pointers represent
+ * the offspring, where the path through each component is taken from T2
+ * if FromT2 is set for the component, and otherwise from T1 (given by the
+ * OldSuc and OldPred pointers). The function returns 1 if the offspring
+ * is a tour; otherwise 0.
+ */
+
+static int BuildOffspring()
+{
+    Node *N = FirstNode, *Prev = FirstNode, *Next;
+    int Count = 0;
+
+    Next = Comp[N->Rank].FromT2 ? N->Next : N->OldSuc;
+    do {
+        (N->Suc = Next)->Pred = N;
+        Prev = N;
+        N = Next;
+        if (Comp[N->Rank].FromT2)
+            Next = N->Next != Prev ? N->Next : N->Prev;
+        else
+            Next = N->OldSuc != Prev ? N->OldSuc : N->OldPred;
+        Count++;
+    } while (N != FirstNode && Count <= Dimension);
+    return N == FirstNode && Count == Dimension;
+}
+
+/*
+ * The Find function returns the root of component k in the union-find
+ * forest (with path halving).
+ */
+
+static int Find(int k)
+{
+    while (Comp[k].Root != k)
+        k = Comp[k].Root = Comp[Comp[k].Root].Root;
+    return k;
+}
+
+/*
+ * The Fuse function fuses the (unfused) component k into the group of
+ * components with root G, and updates the number of entries of the group.
+ */
+
+static void Fuse(int G, int k)
+{
+    Node *N;
+    int Edges = 0;
+
+    for (N = Comp[k].First; N; N = N->Mark)
+        Edges += (Find(N->OldSuc->Rank) == G) + (Find(N->OldPred->Rank) == G);
+    Comp[G].Entries += Comp[k].Entries - 2 * Edges;
+    Comp[k].Root = G;
+}
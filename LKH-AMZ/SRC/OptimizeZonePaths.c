@@ -0,0 +1,274 @@
+#include "LKH.h"
+
+/*
+ * The OptimizeZonePaths function improves the current tour (held in Suc)
+ * by optimizing the order of the nodes within each cluster (zone).
+ *
+ * The tour is divided into segments, where a segment is a maximal
+ * sequence of consecutive nodes of the same cluster (the depot always
+ * stays first). Given the node, P, preceding a segment and the node, S,
+ * following it, the nodes of the segment are reordered into a shortest
+ * Hamiltonian path from P to S. The path is found exactly by dynamic
+ * programming (Held-Karp) if the segment has at most MaxExact nodes, and
+ * otherwise by or-opt moves.
+ *
+ * A segment is left unchanged if the path from P to S contains a fixed
+ * edge (e.g., a backbone edge fixed by UpdateBackbone).
+ *
+ * Reordering a segment does not change the order of the clusters, and
+ * hence the zone penalties. It may, however, change the time window
+ * penalty, so a new segment order is only kept if it does not increase
+ * the penalty.
+ *
+ * The function is called after FindTour, when CurrentPenalty is the
+ * penalty of the tour. On return, CurrentPenalty is the penalty of the
+ * improved tour, and the function returns its cost.
+ */
+
+#define Twin(N) (&NodeSet[(N)->Id + DimensionSaved])
+#define MaxExact 12
+#define MaxSegment 3
+
+static Node **Path, **NewPath;
+static long long *Length;
+static int *Pred;
+
+static void ExactPath(Node * P, Node * S, int Size);
+static int FixedPath(Node * P, Node ** Path, int Size, Node * S);
+static void ImprovePath(Node * P, Node * S, int Size);
+static void LinkPath(Node * P, Node ** Path, int Size, Node * S);
+static long long PathCost(Node * P, Node ** Path, int Size, Node * S);
+static long long TravelCost(Node * Na, Node * Nb);
+
+long long OptimizeZonePaths()
+{
+    Node *N, *P, *S, **Tour;
+    long long Cost = 0, OldPathCost, NewPathCost, NewPenalty;
+    int i, j, Size, Improved = 0;
+
+    /* Collect the nodes in tour order, starting at the depot */
+    Tour = (Node **) malloc(DimensionSaved * sizeof(Node *));
+    N = Depot;
+    for (i = 0; i < DimensionSaved; i++) {
+        Tour[i] = N;
+        N = N->Suc != Twin(N) ? N->Suc : N->Pred;
+        N = &NodeSet[N->Id - DimensionSaved];
+    }
+    Path = (Node **) malloc(DimensionSaved * sizeof(Node *));
+    NewPath = (Node **) malloc(DimensionSaved * sizeof(Node *));
+    Length = (long long *) malloc(MaxExact * (1 << MaxExact) *
+                                  sizeof(long long));
+    Pred = (int *) malloc(MaxExact * (1 << MaxExact) * sizeof(int));
+
+    /* Let the tour run forward: Depot, Twin(N1), N1, Twin(N2), ... */
+    LinkPath(Depot, &Tour[1], DimensionSaved - 1, Depot);
+    Link(Twin(Depot), Depot);
+    Reversed = 0;
+
+    for (i = 1; i < DimensionSaved; i = j) {
+        for (j = i + 1; j < DimensionSaved &&
+             Tour[j]->MyCluster == Tour[i]->MyCluster; j++);
+        if ((Size = j - i) < 2)
+            continue;
+        P = Tour[i - 1];
+        S = j < DimensionSaved ? Tour[j] : Depot;
+        if (FixedPath(P, &Tour[i], Size, S))
+            continue;
+        memcpy(Path, &Tour[i], Size * sizeof(Node *));
+        OldPathCost = PathCost(P, Path, Size, S);
+        if (Size <= MaxExact)
+            ExactPath(P, S, Size);
+        else
+            ImprovePath(P, S, Size);
+        if ((NewPathCost = PathCost(P, Path, Size, S)) >= OldPathCost)
+            continue;
+        LinkPath(P, Path, Size, S);
+        if (TimeWindowsUsed &&
+            (NewPenalty = Penalty()) > CurrentPenalty) {
+            LinkPath(P, &Tour[i], Size, S);
+            continue;
+        }
+        if (TimeWindowsUsed)
+            CurrentPenalty = NewPenalty;
+        memcpy(&Tour[i], Path, Size * sizeof(Node *));
+        Improved = 1;
+    }
+
+    free(Tour);
+    free(Path);
+    free(NewPath);
+    free(Length);
+    free(Pred);
+
+    N = FirstNode;
+    do {
+        Cost += C(N, N->Suc) - N->Pi - N->Suc->Pi;
+        N->BestSuc = N->Suc;
+    }
+    while ((N = N->Suc) != FirstNode);
+    if (Improved && HashingUsed) {
+        Hash = 0;
+        do
+            Hash ^= Rand[N->Id] * Rand[N->Suc->Id];
+        while ((N = N->Suc) != FirstNode);
+    }
+    return Cost / Precision + BackboneCost();
+}
+
+/*
+ * The ExactPath function finds a shortest Hamiltonian path from P to S
+ * through the nodes Path[0..Size-1] by dynamic programming. Length[T *
+ * Size + k] is the length of a shortest path from P through the nodes of
+ * the subset T ending at Path[k], and Pred[T * Size + k] the index of the
+ * node preceding Path[k] on this path. On return, the nodes of Path have
+ * been reordered.
+ */
+
+static void ExactPath(Node * P, Node * S, int Size)
+{
+    unsigned T, Full = (1U << Size) - 1;
+    long long Min, L;
+    int k, m, Last = -1;
+
+    for (T = 1; T <= Full; T++) {
+        for (k = 0; k < Size; k++) {
+            if (!(T & (1U << k)))
+                continue;
+            if (T == (1U << k)) {
+                Length[T * Size + k] = TravelCost(P, Path[k]);
+                Pred[T * Size + k] = -1;
+                continue;
+            }
+            Min = LLONG_MAX;
+            for (m = 0; m < Size; m++) {
+                if (m == k || !(T & (1U << m)))
+                    continue;
+                L = Length[(T ^ (1U << k)) * Size + m] +
+                    TravelCost(Path[m], Path[k]);
+                if (L < Min) {
+                    Min = L;
+                    Pred[T * Size + k] = m;
+                }
+            }
+            Length[T * Size + k] = Min;
+        }
+    }
+    Min = LLONG_MAX;
+    for (k = 0; k < Size; k++) {
+        L = Length[Full * Size + k] + TravelCost(Path[k], S);
+        if (L < Min) {
+            Min = L;
+            Last = k;
+        }
+    }
+    for (T = Full, k = Size - 1; k >= 0; k--) {
+        NewPath[k] = Path[Last];
+        m = Pred[T * Size + Last];
+        T ^= 1U << Last;
+        Last = m;
+    }
+    memcpy(Path, NewPath, Size * sizeof(Node *));
+}
+
+/*
+ * The ImprovePath function improves the path from P through the nodes
+ * Path[0..Size-1] to S by or-opt moves.
+ */
+
+static void ImprovePath(Node * P, Node * S, int Size)
+{
+    long long BestCost = PathCost(P, Path, Size, S), NewCost;
+    int i, j, k, L, Count, Improved;
+
+    do {
+        Improved = 0;
+        for (L = 1; L <= MaxSegment; L++) {
+            for (i = 0; i + L <= Size; i++) {
+                for (j = -1; j < Size; j++) {
+                    if (j >= i - 1 && j <= i + L - 1)
+                        continue;
+                    /* Move Path[i..i+L-1] to follow Path[j] (or P) */
+                    Count = 0;
+                    if (j == -1) {
+                        memcpy(NewPath, &Path[i], L * sizeof(Node *));
+                        Count = L;
+                    }
+                    for (k = 0; k < Size; k++) {
+                        if (k >= i && k <= i + L - 1)
+                            continue;
+                        NewPath[Count++] = Path[k];
+                        if (k == j) {
+                            memcpy(&NewPath[Count], &Path[i],
+                                   L * sizeof(Node *));
+                            Count += L;
+                        }
+                    }
+                    if ((NewCost = PathCost(P, NewPath, Size, S)) <
+                        BestCost) {
+                        BestCost = NewCost;
+                        memcpy(Path, NewPath, Size * sizeof(Node *));
+                        Improved = 1;
+                    }
+                }
+            }
+        }
+    } while (Improved);
+}
+
+/*
+ * The LinkPath function links P, Path[0..Size-1], and S in the forward
+ * orientation of the tour.
+ */
+
+static void LinkPath(Node * P, Node ** Path, int Size, Node * S)
+{
+    int i;
+
+    for (i = 0; i < Size; i++) {
+        Link(P, Twin(Path[i]));
+        Link(Twin(Path[i]), Path[i]);
+        P = Path[i];
+    }
+    Link(P, Twin(S));
+}
+
+static long long PathCost(Node * P, Node ** Path, int Size, Node * S)
+{
+    long long Cost = 0;
+    int i;
+
+    for (i = 0; i < Size; i++) {
+        Cost += TravelCost(P, Path[i]);
+        P = Path[i];
+    }
+    return Cost + TravelCost(P, S);
+}
+
+/*
+ * The FixedPath function returns 1 if the path from P through the nodes
+ * Path[0..Size-1] to S contains a fixed edge; otherwise 0.
+ */
+
+static int FixedPath(Node * P, Node ** Path, int Size, Node * S)
+{
+    int i;
+
+    for (i = 0; i < Size; i++) {
+        if (Fixed(P, Twin(Path[i])))
+            return 1;
+        P = Path[i];
+    }
+    return Fixed(P, Twin(S));
+}
+
+/*
+ * The TravelCost function returns the cost of going from node Na to
+ * node Nb, where Na and Nb are original (not twin) nodes.
+ */
+
+static long long TravelCost(Node * Na, Node * Nb)
+{
+    Node *Tb = Twin(Nb);
+
+    return (long long) C(Na, Tb) - Na->Pi - Tb->Pi;
+}
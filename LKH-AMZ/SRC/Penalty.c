@@ -13,8 +13,18 @@ static inline int max(int a, int b) {
 
 static int *ZoneRank = 0, *SuperZoneRank = 0, *SuperSuperZoneRank = 0;
 
+static void AllocateRanks()
+{
+    ZoneRank = (int *) malloc((1 + GTSPSets) * sizeof(int));
+    SuperZoneRank = (int *) malloc((1 + SuperGTSPSets) * sizeof(int));
+    SuperSuperZoneRank =
+        (int *) malloc((1 + SuperSuperGTSPSets) * sizeof(int));
+}
+
 long long Penalty()
 {
+    if (StatsFileName)
+        Stats.PenaltyCalls++;
     if (!PenaltyUsed || GTSPSets == 0)
         return 0;
     Node *N = Depot, *NextN = 0;
@@ -24,12 +34,8 @@ long long Penalty()
         SuperSuperClusterEntrances = 0;
     Cluster *LastCluster;
 
-    if (!ZoneRank) {
-        ZoneRank = (int *) malloc((1 + GTSPSets) * sizeof(int));
-        SuperZoneRank = (int *) malloc((1 + SuperGTSPSets) * sizeof(int));
-        SuperSuperZoneRank = 
-            (int *) malloc((1 + SuperSuperGTSPSets) * sizeof(int));
-    }
+    if (!ZoneRank)
+        AllocateRanks();
     LastCluster = N->MyCluster;
     ZoneRank[N->MyCluster->Id] = ++ClusterEntrances;
     if (SuperGTSPSets) {
@@ -79,7 +85,8 @@ long long Penalty()
                Sum += N->ServiceTime;
             }
             NextN = Forward ? N->Suc : N->Pred;
-            Sum += (C(N, NextN) - N->Pi - NextN->Pi) / Precision;
+            Sum += N->BackboneFixedTo == NextN ? Distance(N, NextN) :
+                (C(N, NextN) - N->Pi - NextN->Pi) / Precision;
             N = Forward ? NextN->Suc : NextN->Pred;
         } while (N != Depot);
         if (Sum > Depot->Latest) {
@@ -143,6 +150,60 @@ long long Penalty()
     return P;
 }
 
+/*
+ * The SequencePenalty function returns the penalty of a tour that visits
+ * the clusters in the order Sequence[1..GTSPSets], where Sequence[1] is
+ * the cluster of the depot, and each cluster is visited only once. Time
+ * windows are not taken into account.
+ */
+
+long long SequencePenalty(Cluster ** Sequence)
+{
+    Cluster *Cl, *LastCluster = Sequence[1];
+    long long P;
+    int SuperClusterEntrances = 0, SuperSuperClusterEntrances = 0, i;
+
+    if (!PenaltyUsed || GTSPSets == 0)
+        return 0;
+    if (!ZoneRank)
+        AllocateRanks();
+    for (i = 1; i <= GTSPSets; i++) {
+        Cl = Sequence[i];
+        ZoneRank[Cl->Id] = i;
+        if (SuperGTSPSets &&
+            (i == 1 || Cl->MySuperCluster != LastCluster->MySuperCluster)) {
+            SuperZoneRank[Cl->MySuperCluster->Id] = ++SuperClusterEntrances;
+            if (SuperSuperGTSPSets &&
+                (i == 1 || Cl->MySuperCluster->MySuperSuperCluster !=
+                 LastCluster->MySuperCluster->MySuperSuperCluster))
+                SuperSuperZoneRank[Cl->MySuperCluster->
+                    MySuperSuperCluster->Id] = ++SuperSuperClusterEntrances;
+        }
+        LastCluster = Cl;
+    }
+    P = 10 * (max(0, SuperClusterEntrances - SuperGTSPSets) +
+              max(0, SuperSuperClusterEntrances - SuperSuperGTSPSets));
+    P += Zone_Penalty(FirstZoneNeighborConstraint, OK_Neighbor,
+                      ZoneRank, GTSPSets, 1);
+    P += Zone_Penalty(FirstZonePathConstraint, OK_Path,
+                      ZoneRank, GTSPSets, 1);
+    P += Zone_Penalty(FirstZonePrecedenceConstraint, OK_Precedence,
+                      ZoneRank, GTSPSets, 1);
+    P += Zone_Penalty(FirstSuperZoneNeighborConstraint, OK_Neighbor,
+                      SuperZoneRank, SuperClusterEntrances, 1000);
+    P += Zone_Penalty(FirstSuperZonePathConstraint, OK_Path,
+                      SuperZoneRank, SuperClusterEntrances, 1000);
+    P += Zone_Penalty(FirstSuperZonePrecedenceConstraint, OK_Precedence,
+                      SuperZoneRank, SuperClusterEntrances, 1000);
+    P += Zone_Penalty(FirstSuperSuperZoneNeighborConstraint, OK_Neighbor,
+                      SuperSuperZoneRank, SuperSuperClusterEntrances, 1000);
+    P += Zone_Penalty(FirstSuperSuperZonePathConstraint, OK_Path,
+                      SuperSuperZoneRank, SuperSuperClusterEntrances, 1000);
+    P += Zone_Penalty(FirstSuperSuperZonePrecedenceConstraint, OK_Precedence,
+                      SuperSuperZoneRank, SuperSuperClusterEntrances, 1000);
+    return P;
+}
+
 #define InOrder(A, B, Rank, Count)\
     (Rank[A] < Count ? Rank[B] == Rank[A] + 1 : Rank[B] == 1)
 
@@ -188,34 +249,41 @@ static long long Zone_Penalty(ZoneConstraint *Z, OK_Function OK,
     return P;
 }
 
-long long TotalTWViolation(int *num_violation)
-{
-  Node *N = Depot, *NextN = 0;
-  long long P = 0, Sum = 0;
-    int Forward = (SUC(N)->Id != N->Id + DimensionSaved) == !Reversed;
+/*
+ * The TotalTWViolation function returns the total time window violation
+ * of the tour given by the array Tour (see RecordBetterTour), and counts
+ * the violated time windows in *num_violation. The tour in Suc and Pred
+ * is not used, so the function may be applied to any recorded tour.
+ */
 
-    Cluster *LastCluster;
+long long TotalTWViolation(int *Tour, int *num_violation)
+{
+    Node *N, *NextN;
+    long long P = 0, Sum = 0;
+    Cluster *LastCluster = Depot->MyCluster;
+    int i, j;
 
-    LastCluster = N->MyCluster;
-    do {
-        if (N->Id <= DimensionSaved) {
-            if (N->MyCluster != LastCluster) {
-                LastCluster = N->MyCluster;
-                Sum -= MM;
-            }
-            if (Sum < N->Earliest) {
-              Sum = N->Earliest ;
-            }
-            else if (Sum > N->Latest) {
-              P += Sum - N->Latest ;
-              (*num_violation)++;
-            }
-            Sum += N->ServiceTime;
+    for (i = 1; Tour[i] != Depot->Id; i++);
+    for (j = 1; j <= DimensionSaved; j++) {
+        N = &NodeSet[Tour[i]];
+        if (N->MyCluster != LastCluster) {
+            LastCluster = N->MyCluster;
+            Sum -= MM;
         }
-        NextN = Forward ? N->Suc : N->Pred;
-        Sum += (C(N, NextN) - N->Pi - NextN->Pi) / Precision;
-        N = Forward ? NextN->Suc : NextN->Pred;
-    } while (N != Depot);
+        if (Sum < N->Earliest)
+            Sum = N->Earliest;
+        else if (Sum > N->Latest) {
+            P += Sum - N->Latest;
+            (*num_violation)++;
+        }
+        Sum += N->ServiceTime;
+        if (++i > DimensionSaved)
+            i = 1;
+        /* The twin of the next node */
+        NextN = &NodeSet[Tour[i] + DimensionSaved];
+        Sum += N->BackboneFixedTo == NextN ? Distance(N, NextN) :
+            (C(N, NextN) - N->Pi - NextN->Pi) / Precision;
+    }
     if (Sum > Depot->Latest) {
         P += Sum - Depot->Latest;
         if (P > CurrentPenalty) {
@@ -0,0 +1,17 @@
+#include "LKH.h"
+
+/*
+ * The Preempted function is called from inside long-running computations
+ * (LinKernighan, Ascent and GenerateCandidates) in order to make the time
+ * limit a bound on the latency of the program. It returns 1 if the time
+ * limit has been reached (and cannot be extended); otherwise 0.
+ *
+ * The function reads the clock at each call. The callers are responsible
+ * for calling it sparingly.
+ */
+
+int Preempted()
+{
+    return TimeLimit != DBL_MAX && GetTime() - StartTime >= TimeLimit &&
+        TimeLimitExceeded();
+}
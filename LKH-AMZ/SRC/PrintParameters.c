@@ -1,4 +1,5 @@
 #include "LKH.h"
+#include "Genetic.h"
 
 /*
  * The PrintParameters function prints the problem parameters to
@@ -7,9 +8,25 @@
 
 void PrintParameters()
 {
+    printff("ADAPTIVE_KICKING = %s\n", AdaptiveKicking ? "YES" : "NO");
     printff("ASCENT_CANDIDATES = %d\n", AscentCandidates);
+    printff("BACKBONE_RUNS = %d\n", BackboneRuns);
+    printff("CANDIDATE_SET_TYPE = %s\n",
+            CandidateSetType == NN ? "NEAREST-NEIGHBOR" : "ALPHA");
+    printff("CANDIDATE_THREADS = %d\n", CandidateThreads);
+    printff("%sCHECKPOINT_FILE = %s\n",
+            CheckpointFileName ? "" : "# ",
+            CheckpointFileName ? CheckpointFileName : "");
+    if (CheckpointInterval == DBL_MAX)
+        printff("# CHECKPOINT_INTERVAL =\n");
+    else
+        printff("CHECKPOINT_INTERVAL = %0.1f\n", CheckpointInterval);
+    printff("%sCONVERGENCE_FILE = %s\n",
+            ConvergenceFileName ? "" : "# ",
+            ConvergenceFileName ? ConvergenceFileName : "");
     printff("CTSP_TRANSFORM = %s\n", CTSPTransform ? "YES" : "NO");
     printff("DEPOT = %d\n", MTSPDepot);
+    printff("EXACT_DIMENSION = %d\n", ExactDimension);
     if (Excess >= 0)
         printff("EXCESS = %g\n", Excess);
     else
@@ -18,28 +35,62 @@ void PrintParameters()
         printff("INITIAL_PERIOD = %d\n", InitialPeriod);
     else
         printff("# INITIAL_PERIOD =\n");
-    printff("KICK_TYPE = %d\n", KickType);
+    printff("INITIAL_TOUR_ALGORITHM = %s\n",
+            InitialTourAlgorithm == ZONE ? "ZONE" :
+            InitialTourAlgorithm == HIERARCHICAL ? "HIERARCHICAL" : "WALK");
+    printff("%sINITIAL_TOUR_FILE = %s\n",
+            InitialTourFileName ? "" : "# ",
+            InitialTourFileName ? InitialTourFileName : "");
+    printff("INTRA_ZONE_OPTIMIZATION = %s\n",
+            IntraZoneOptimization ? "YES" : "NO");
+    printff("KICK_TYPE = %d%s\n", KickType, ZoneKick ? " ZONE" : "");
     printff("MAX_CANDIDATES = %d %s\n",
             MaxCandidates, CandidateSetSymmetric ? "SYMMETRIC" : "");
     if (MaxTrials >= 0)
         printff("MAX_TRIALS = %d\n", MaxTrials);
     else
         printff("# MAX_TRIALS =\n");
+    printff("MERGE_ALGORITHM = %s\n",
+            MergeAlgorithm == GPX ? "GPX" : "IPT");
+    printff("%sMERGE_TOUR_FILE = %s\n",
+            MergeTourFileName ? "" : "# ",
+            MergeTourFileName ? MergeTourFileName : "");
     printff("MERGING = %s\n", MergingUsed ? "YES" : "NO");
+    if (MinImprovementRate > 0)
+        printff("MIN_IMPROVEMENT_RATE = %g %g\n",
+                MinImprovementRate, ImprovementRateWindow);
+    else
+        printff("# MIN_IMPROVEMENT_RATE =\n");
     printff("PENALTY = %s\n", PenaltyUsed ? "YES" : "NO");
     printff("PENALTY_MULTIPLIER = %d\n", PenaltyMultiplier);
+    printff("POPULATION_SIZE = %d\n", MaxPopulationSize);
     printff("PRECISION = %d\n", Precision);
     printff("%sPROBLEM_FILE = %s\n",
             ProblemFileName ? "" : "# ",
             ProblemFileName ? ProblemFileName : "");
     printff("RUNS = %d\n", Runs);
     printff("SEED = %u\n", Seed);
+    printff("SPARSE_NEIGHBORS = %d\n", SparseNeighbors);
+    if (StagnationTime == DBL_MAX)
+        printff("# STAGNATION_TIME =\n");
+    else
+        printff("STAGNATION_TIME = %0.1f\n", StagnationTime);
+    printff("STAGNATION_TRIALS = %d\n", StagnationTrials);
+    printff("%sSTATS_FILE = %s\n",
+            StatsFileName ? "" : "# ", StatsFileName ? StatsFileName : "");
     printff("SUBGRADIENT = %s\n", Subgradient ? "YES" : "NO");
+    printff("TIME_EXTENSION = %0.1f\n", TimeExtension);
     if (TimeLimit == DBL_MAX)
         printff("# TIME_LIMIT =\n");
     else
         printff("TIME_LIMIT = %0.1f\n", TimeLimit);
+    printff("TIME_WINDOW_PRUNING = %s\n",
+            TimeWindowPruning == DEMOTE ? "DEMOTE" :
+            TimeWindowPruning == DROP ? "DROP" : "NO");
     printff("%sTOUR_FILE = %s\n",
             TourFileName ? "" : "# ", TourFileName ? TourFileName : "");
     printff("TRACE_LEVEL = %d\n", TraceLevel);
+    printff("ZONE_PRUNING = %s\n",
+            ZonePruning == DEMOTE ? "DEMOTE" :
+            ZonePruning == DROP ? "DROP" : "NO");
 }
@@ -0,0 +1,43 @@
+#include "LKH.h"
+
+/*
+ * The PruneCandidates function removes (Type = DROP) or moves to the end
+ * of the candidate lists (Type = DEMOTE) those candidate edges (From,To)
+ * for which Infeasible(From,To) returns 1. The relative order of the
+ * remaining edges, and of the demoted edges, is preserved. Fixed edges
+ * are never pruned.
+ *
+ * The function returns the number of pruned candidate edges.
+ *
+ * It is used by PruneZoneCandidates and PruneTimeWindowCandidates.
+ */
+
+int PruneCandidates(int (*Infeasible) (Node * Na, Node * Nb), int Type)
+{
+    Node *From = FirstNode;
+    Candidate *NFrom, *NN, *Pruned;
+    int i, k, Count, PrunedCount = 0;
+
+    do {
+        if (!From->CandidateSet)
+            continue;
+        for (Count = 0; From->CandidateSet[Count].To; Count++);
+        Pruned = (Candidate *) malloc((Count + 1) * sizeof(Candidate));
+        /* Keep the feasible edges in order, collect the others */
+        NN = From->CandidateSet;
+        for (NFrom = From->CandidateSet, k = 0; NFrom->To; NFrom++) {
+            if (!Fixed(From, NFrom->To) && Infeasible(From, NFrom->To))
+                Pruned[k++] = *NFrom;
+            else
+                *NN++ = *NFrom;
+        }
+        if (Type == DEMOTE)
+            for (i = 0; i < k; i++)
+                *NN++ = Pruned[i];
+        NN->To = 0;
+        PrunedCount += k;
+        free(Pruned);
+    }
+    while ((From = From->Suc) != FirstNode);
+    return PrunedCount;
+}
@@ -0,0 +1,171 @@
+#include "LKH.h"
+
+/*
+ * The PruneTimeWindowCandidates function removes (TIME_WINDOW_PRUNING =
+ * DROP) or moves to the end of the candidate lists (TIME_WINDOW_PRUNING =
+ * DEMOTE) those candidate edges that cannot belong to a tour in which all
+ * time windows are met.
+ *
+ * Going from node i to node j is impossible if
+ *
+ *     Earliest(i) + ServiceTime(i) + Travel(i,j) > Latest(j),
+ *
+ * since service at j would then start too late, however early i is
+ * served (if the condition holds, j must precede i in any tour without
+ * time window violations). Travel(i,j) is the travel time from i to j
+ * as used by the Penalty function, i.e., without the MM added to edges
+ * between clusters.
+ *
+ * Before the test, the windows are tightened from the depot:
+ *
+ *   (1) The service at j cannot start before the earliest possible
+ *       arrival at j when the tour starts at the depot at time 0. The
+ *       arrival times are computed by Dijkstra's algorithm, where a node
+ *       is left when it has been served (after waiting for its Earliest).
+ *   (2) The service at j must start early enough for the tour to return
+ *       to the depot no later than Latest(depot). The latest start times
+ *       are computed by Dijkstra's algorithm backwards from the depot.
+ *
+ * The tightened windows are only used for the pruning; the windows of
+ * the nodes are left unchanged. If some travel time is negative, the
+ * windows are not tightened.
+ *
+ * The function is called by CreateCandidateSet after the candidates have
+ * been generated. The pruning itself is made by PruneCandidates.
+ */
+
+#define Twin(N) (&NodeSet[(N)->Id + DimensionSaved])
+#define Original(N) ((N)->Id <= DimensionSaved ? (N) :\
+                     &NodeSet[(N)->Id - DimensionSaved])
+
+static double *Earliest, *Latest;
+
+static void Tighten(void);
+static double Travel(Node * Na, Node * Nb);
+static int Infeasible(Node * Na, Node * Nb);
+
+void PruneTimeWindowCandidates()
+{
+    Node *N;
+    int i, Pruned;
+
+    if (!TimeWindowsUsed || Dimension != 2 * DimensionSaved)
+        return;
+    Earliest = (double *) malloc((DimensionSaved + 1) * sizeof(double));
+    Latest = (double *) malloc((DimensionSaved + 1) * sizeof(double));
+    for (i = 1; i <= DimensionSaved; i++) {
+        N = &NodeSet[i];
+        Earliest[i] = N->Earliest;
+        Latest[i] = N->Latest;
+    }
+    if (Depot->Earliest < 0)
+        Earliest[Depot->Id] = 0;
+    Tighten();
+    Pruned = PruneCandidates(Infeasible, TimeWindowPruning);
+    free(Earliest);
+    free(Latest);
+    if (TraceLevel >= 2)
+        printff("Time window pruning: %d candidate edges %s\n", Pruned,
+                TimeWindowPruning == DEMOTE ? "demoted" : "dropped");
+}
+
+/*
+ * The Tighten function tightens the windows in Earliest and Latest as
+ * described above. Latest[Depot->Id] is the latest return to the depot.
+ */
+
+static void Tighten()
+{
+    Node *N, *Best;
+    double *Label, T;
+    char *Done;
+    int i, j;
+
+    for (i = 1; i <= DimensionSaved; i++)
+        for (j = 1; j <= DimensionSaved; j++)
+            if (i != j && Travel(&NodeSet[i], &NodeSet[j]) < 0)
+                return;
+    Label = (double *) malloc((DimensionSaved + 1) * sizeof(double));
+    Done = (char *) malloc(DimensionSaved + 1);
+
+    /* (1) Earliest arrival times */
+    for (i = 1; i <= DimensionSaved; i++) {
+        Label[i] = DBL_MAX;
+        Done[i] = 0;
+    }
+    Label[Depot->Id] = 0;
+    for (i = 1; i <= DimensionSaved; i++) {
+        Best = 0;
+        for (j = 1; j <= DimensionSaved; j++)
+            if (!Done[j] && (!Best || Label[j] < Label[Best->Id]))
+                Best = &NodeSet[j];
+        Done[Best->Id] = 1;
+        if (Label[Best->Id] > Earliest[Best->Id])
+            Earliest[Best->Id] = Label[Best->Id];
+        for (j = 1; j <= DimensionSaved; j++) {
+            N = &NodeSet[j];
+            if (!Done[j] && N != Depot &&
+                (T = Earliest[Best->Id] + Best->ServiceTime +
+                 Travel(Best, N)) < Label[j])
+                Label[j] = T;
+        }
+    }
+
+    /* (2) Latest start times, backwards from the depot */
+    for (i = 1; i <= DimensionSaved; i++) {
+        Label[i] = -DBL_MAX;
+        Done[i] = 0;
+    }
+    Label[Depot->Id] = Latest[Depot->Id];
+    Done[Depot->Id] = 1;
+    Best = Depot;
+    for (i = 1; i < DimensionSaved; i++) {
+        for (j = 1; j <= DimensionSaved; j++) {
+            if (Done[j])
+                continue;
+            N = &NodeSet[j];
+            T = Label[Best->Id] - Travel(N, Best) - N->ServiceTime;
+            if (T > Latest[j])
+                T = Latest[j];
+            if (T > Label[j])
+                Label[j] = T;
+        }
+        Best = 0;
+        for (j = 1; j <= DimensionSaved; j++)
+            if (!Done[j] && (!Best || Label[j] > Label[Best->Id]))
+                Best = &NodeSet[j];
+        Done[Best->Id] = 1;
+        Latest[Best->Id] = Label[Best->Id];
+    }
+    free(Label);
+    free(Done);
+}
+
+/*
+ * The Travel function returns the travel time from node Na to node Nb,
+ * where Na and Nb are original (not twin) nodes.
+ */
+
+static double Travel(Node * Na, Node * Nb)
+{
+    return (double) Distance(Na, Twin(Nb)) -
+        (Na->MyCluster != Nb->MyCluster ? MM : 0);
+}
+
+/*
+ * The Infeasible function returns 1 if going from the original node of
+ * the edge (Na,Nb) to the original node of its twin node would violate a
+ * time window; otherwise 0.
+ */
+
+static int Infeasible(Node * Na, Node * Nb)
+{
+    Node *Tail, *Head;
+
+    if (Forbidden(Na, Nb))
+        return 0;
+    Tail = Na->Id <= DimensionSaved ? Na : Nb;
+    Head = Original(Tail == Na ? Nb : Na);
+    return Earliest[Tail->Id] + Tail->ServiceTime + Travel(Tail, Head) >
+        Latest[Head->Id];
+}
@@ -0,0 +1,114 @@
+#include "LKH.h"
+
+/*
+ * The PruneZoneCandidates function removes (ZONE_PRUNING = DROP) or moves
+ * to the end of the candidate lists (ZONE_PRUNING = DEMOTE) those
+ * candidate edges that cannot belong to a tour satisfying the precedence
+ * constraints of the problem.
+ *
+ * Let A < B denote that zone A must be visited before zone B. This
+ * relation is determined from the ZONE_PRECEDENCE_SECTION, and from the
+ * SUPER_ZONE_PRECEDENCE_SECTION and SUPER_SUPER_ZONE_PRECEDENCE_SECTION
+ * (a zone precedes another zone if its super zone precedes the super zone
+ * of the other), and closed under transitivity. Only constraints that are
+ * not part of a disjunction (OR) are used. If A < B, then no tour that
+ * satisfies the constraints can go directly from a node of zone B to a
+ * node of zone A.
+ *
+ * An edge (Na,Nb) of the transformed problem, where Na is an original
+ * node and Nb is a twin node, represents going from Na to the original
+ * node of Nb. Fixed edges and edges entering the depot are never pruned.
+ *
+ * The function is called by CreateCandidateSet after the candidates have
+ * been generated. The pruning itself is made by PruneCandidates.
+ */
+
+#define Original(N) ((N)->Id <= DimensionSaved ? (N) :\
+                     &NodeSet[(N)->Id - DimensionSaved])
+
+static char **Before;
+
+static void AddPrecedences(ZoneConstraint * Z, int Level);
+static int Infeasible(Node * Na, Node * Nb);
+
+void PruneZoneCandidates()
+{
+    int i, j, k, Pruned;
+
+    if (!PenaltyUsed || GTSPSets == 0 || Dimension != 2 * DimensionSaved)
+        return;
+    Before = (char **) malloc((GTSPSets + 1) * sizeof(char *));
+    for (i = 1; i <= GTSPSets; i++)
+        Before[i] = (char *) calloc(GTSPSets + 1, sizeof(char));
+    AddPrecedences(FirstZonePrecedenceConstraint, 0);
+    AddPrecedences(FirstSuperZonePrecedenceConstraint, 1);
+    AddPrecedences(FirstSuperSuperZonePrecedenceConstraint, 2);
+    /* Transitive closure (Warshall) */
+    for (k = 1; k <= GTSPSets; k++)
+        for (i = 1; i <= GTSPSets; i++)
+            if (Before[i][k])
+                for (j = 1; j <= GTSPSets; j++)
+                    if (Before[k][j])
+                        Before[i][j] = 1;
+
+    Pruned = PruneCandidates(Infeasible, ZonePruning);
+
+    for (i = 1; i <= GTSPSets; i++)
+        free(Before[i]);
+    free(Before);
+    if (TraceLevel >= 2)
+        printff("Zone pruning: %d candidate edges %s\n", Pruned,
+                ZonePruning == DEMOTE ? "demoted" : "dropped");
+}
+
+/*
+ * The AddPrecedences function adds the precedences given by the list Z to
+ * Before. Level is 0 for zones, 1 for super zones, and 2 for super super
+ * zones.
+ */
+
+static void AddPrecedences(ZoneConstraint * Z, int Level)
+{
+    Cluster *Ca, *Cb;
+    int A, B, InDisjunction = 0;
+
+    for (; Z; InDisjunction = Z->Type == OR, Z = Z->Next) {
+        if (InDisjunction || Z->Type == OR)
+            continue;
+        for (Ca = FirstCluster; Ca; Ca = Ca->Next) {
+            A = Level == 0 ? Ca->Id :
+                Level == 1 ? Ca->MySuperCluster->Id :
+                Ca->MySuperCluster->MySuperSuperCluster->Id;
+            if (A != Z->A)
+                continue;
+            for (Cb = FirstCluster; Cb; Cb = Cb->Next) {
+                B = Level == 0 ? Cb->Id :
+                    Level == 1 ? Cb->MySuperCluster->Id :
+                    Cb->MySuperCluster->MySuperSuperCluster->Id;
+                if (B == Z->B && Cb != Ca)
+                    Before[Ca->Id][Cb->Id] = 1;
+            }
+        }
+    }
+}
+
+/*
+ * The Infeasible function returns 1 if the edge (Na,Nb) leads from a
+ * zone to a zone that must precede it; otherwise 0.
+ */
+
+static int Infeasible(Node * Na, Node * Nb)
+{
+    Node *Tail, *Head;
+    int A, B;
+
+    if (Forbidden(Na, Nb))
+        return 0;
+    Tail = Na->Id <= DimensionSaved ? Na : Nb;
+    Head = Original(Tail == Na ? Nb : Na);
+    if (Head == Depot)
+        return 0;
+    A = Head->MyCluster->Id;
+    B = Tail->MyCluster->Id;
+    return A != B && Before[A][B] && !Before[B][A];
+}
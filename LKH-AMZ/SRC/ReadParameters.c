@@ -1,4 +1,5 @@
 #include "LKH.h"
+#include "Genetic.h"
 
 /*
  * The ReadParameters function reads the name of a parameter file from
@@ -17,18 +18,71 @@
  *
  * Additional control information may be supplied in the following format:
  *
+ * ADAPTIVE_KICKING = { YES | NO }
+ * Specifies whether the kick of each trial is to be chosen adaptively
+ * among K-swap kicks and zone kicks for K = 4, 6, and 8, and the random
+ * walk construction of a new tour. The choice is made by the UCB1 rule
+ * from the improvement per second obtained by each kick so far (see
+ * AdaptiveKick.c). If YES, KICK_TYPE is ignored.
+ * Default: NO
+ *
  * ASCENT_CANDIDATES = <integer>
  * The number of candidate edges to be associated with each node during the
  * ascent. The candidate set is complemented such that every candidate edge
  * is associated with both its two end nodes.
  * Default: 50
  *
+ * BACKBONE_RUNS = <integer>
+ * Specifies that backbone edge fixing is used if the value is positive.
+ * The edges common to the tours of this number of runs (the backbone)
+ * are fixed, so that the following runs search a smaller space. The
+ * fixes are released when this number of runs in a row have not
+ * improved the best tour, and a new backbone is collected.
+ * Default: 0
+ *
+ * CANDIDATE_SET_TYPE = { ALPHA | NEAREST-NEIGHBOR }
+ * Specifies the type of the candidate set. ALPHA uses subgradient
+ * optimization (the ascent) and Alpha-values. NEAREST-NEIGHBOR skips
+ * the ascent and gives each node its MAX_CANDIDATES nearest successors
+ * and predecessors in the cost matrix (see
+ * CreateNearestNeighborCandidateSet.c). NEAREST-NEIGHBOR reduces the
+ * preprocessing time from a number of O(n^2) ascent iterations to a
+ * single O(n^2) scan, at the price of candidate sets of lower quality
+ * (more trials are usually needed to reach the same tour quality). It
+ * pays off when the time limit is short compared to the ascent time.
+ * Default: ALPHA
+ *
+ * CANDIDATE_THREADS = <integer>
+ * Specifies the number of threads used for finding the nearest neighbors
+ * when CANDIDATE_SET_TYPE is NEAREST-NEIGHBOR.
+ * Default: 1
+ *
+ * CHECKPOINT_FILE = <string>
+ * Specifies the name of a file where the best tour found so far is to be
+ * written during the solution process (see CHECKPOINT_INTERVAL). Each
+ * checkpoint overwrites the file; the character $ in the name is replaced
+ * by the string "checkpoint".
+ * Default: TOUR_FILE
+ *
+ * CHECKPOINT_INTERVAL = <real>
+ * Specifies that each time a better tour has been found, it is written
+ * to CHECKPOINT_FILE, as soon as at least the specified number of
+ * seconds have elapsed since the last checkpoint. If the parameter is not
+ * given, no checkpoints are written.
+ * Default: DBL_MAX
+ *
  * COMMENT <string>
  * A comment.
  *
  * # <string>
  * A comment.
  *
+ * CONVERGENCE_FILE = <string>
+ * Specifies the name of a file where a line is written in CSV format
+ * each time a better or a new best tour has been found. The columns are
+ * time, run, trial, penalty, cost, and type (B for better, G for new
+ * global best).
+ *
  * CTSP_TRANSFORM = { YES | NO }
  * Specifies whether the CTSP transform is used.
  * Default: NO
@@ -40,6 +94,12 @@
  * EOF
  * Terminates the input data. The entry is optional.
  *
+ * EXACT_DIMENSION = <integer>
+ * Instances with at most this number of nodes are solved exactly, by
+ * dynamic programming and branch and bound, instead of by the
+ * Lin-Kernighan heuristic. The value must not exceed 20.
+ * Default: 12
+ *
  * EXCESS = <real>
  * The maximum alpha-value allowed for any candidate edge is set to
  * EXCESS times the absolute value of the lower bound of a solution
@@ -58,10 +118,33 @@
  * The length of the first period in the ascent.
  * Default: DIMENSION/2 (but at least 100)
  *
- * KICK_TYPE = <integer>
+ * INITIAL_TOUR_ALGORITHM = { WALK | ZONE | HIERARCHICAL }
+ * Specifies the algorithm for obtaining an initial tour in the first
+ * trial of each run. WALK constructs the tour by a random walk on the
+ * candidate edges. ZONE visits the clusters in an order that respects
+ * the precedence and path constraints, and chains the nodes of each
+ * cluster by nearest candidates. HIERARCHICAL improves the cluster order
+ * of ZONE by solving an ATSP on the clusters that takes the zone
+ * penalties into account, and then traverses each cluster by a path
+ * between chosen entry and exit nodes.
+ * Default: WALK
+ *
+ * INITIAL_TOUR_FILE = <string>
+ * Specifies the name of a file containing a tour (in TSPLIB format) to be
+ * used as the initial tour in the first trial of each run.
+ *
+ * INTRA_ZONE_OPTIMIZATION = { YES | NO }
+ * Specifies whether the tour of each run is improved by reordering the
+ * nodes within each cluster optimally (exactly for clusters of up to 12
+ * nodes), given the nodes before and after the cluster.
+ * Default: NO
+ *
+ * KICK_TYPE = <integer> [ ZONE ]
  * Specifies the value of k for a random k-swap kick (an extension of the
  * double-bridge move). If KICK_TYPE is zero, then the LKH's special kicking
- * strategy, WALK, is used.
+ * strategy, WALK, is used. The integer may be followed by the keyword ZONE,
+ * signifying that the tour is only to be cut at zone boundaries, so that
+ * the kick reorders blocks of whole zones (see ZoneKSwapKick.c).
  * Default: 4
  *
  * MAX_CANDIDATES = <integer> [ SYMMETRIC ]
@@ -84,6 +167,37 @@
  * Specifies whether merging is used.
  * Default: YES
  *
+ * MERGE_ALGORITHM = { IPT | GPX }
+ * Specifies the algorithm used for merging tours. IPT (iterative partial
+ * transcription) repeatedly searches for the smallest subsequences of the
+ * two tours that may be exchanged. GPX (generalized partition crossover)
+ * partitions the union of the two tours into components that are
+ * entered and left only once, and takes the cheaper path through each of
+ * them. GPX is not faster than IPT on instances of the sizes of this
+ * problem. Measured by microbench (BENCH), a merge takes about 14, 47,
+ * 146 and 281 microseconds with GPX for 100, 250, 500 and 1000 nodes,
+ * against 8, 42, 131 and 367 microseconds with IPT.
+ * Default: IPT
+ *
+ * MERGE_TOUR_FILE = <string>
+ * Specifies the name of a file containing a tour (in TSPLIB format) to be
+ * recombined with the tour given by INITIAL_TOUR_FILE. If both files are
+ * given, no runs are made. Instead, the two tours are merged by iterative
+ * partial transcription, and the result is improved by a single run of at
+ * most MAX_TRIALS trials. The resulting tour is written to TOUR_FILE only
+ * if it dominates both input tours, that is, if neither its penalty nor
+ * its cost exceeds those of any of the input tours, and it differs from
+ * each of them in penalty or cost. If the problem is solved exactly
+ * (EXACT_DIMENSION) or by the ascent, no merging is done, but the same
+ * check is applied to the solution.
+ *
+ * MIN_IMPROVEMENT_RATE = <real> [ <real> ]
+ * The search is stopped if the relative improvement of the objective
+ * (PENALTY_MULTIPLIER * penalty + cost) of the best tour during the
+ * last W seconds is less than W times the first real, where W is given
+ * by the second real. The value 0 disables the stopping rule.
+ * Default: 0 [ 1.0 ]
+ *
  * PENALTY = { YES | NO }
  * Specifies whether the penalty function is used.
  * Default: YES
@@ -91,6 +205,16 @@
  * PENALTY_MULTIPLIER = <integer>
  * Default: 1500
  *
+ * POPULATION_SIZE = <integer>
+ * Specifies the maximum size of the population in the genetic algorithm.
+ * If the value is greater than 1, the best tours of the runs are kept in
+ * a population of distinct tours. When the population is full (or after
+ * 2 * POPULATION_SIZE runs), each run starts from the result of merging
+ * two tours of the population, and its tour replaces the most similar of
+ * the tours that are worse than it. Otherwise, the tour of each run is
+ * merged with the best tour (if MERGING is YES).
+ * Default: 0
+ *
  * PRECISION = <integer>
  * The internal precision in the representation of transformed distances:
  *    d[i][j] = PRECISION*c[i][j] + pi[i] + pi[j],
@@ -106,11 +230,55 @@
  * seed is derived from the system clock.
  * Default: 1
  *
+ * SPARSE_NEIGHBORS = <integer>
+ * If positive, only the costs of the specified number of nearest
+ * successors and nearest predecessors of each node are stored, so that
+ * memory is linear in the dimension rather than quadratic. The other
+ * costs are estimated: from the great circle distance if node coordinates
+ * are given (NODE_COORD_SECTION), and otherwise from the stored costs and
+ * the mean of the costs that are not stored (see Distance_SPARSE).
+ * The estimate is used in the candidate generation, the local search and
+ * the Penalty function; a small value may therefore lead to worse tours.
+ * In particular, the time window penalties are computed from estimated
+ * travel times. The cost of a tour is therefore an estimate too, and the
+ * tour file says so ("COMMENT : Estimated cost = ...").
+ * CANDIDATE_SET_TYPE = NEAREST-NEIGHBOR is recommended, since it only
+ * examines the stored costs. If zero, all costs are stored, unless the
+ * dimension exceeds 20000, in which case 50 is used.
+ * Default: 0
+ *
+ * STAGNATION_TIME = <real>
+ * The search is stopped if the best tour has not been improved during
+ * the specified number of seconds.
+ * Default: DBL_MAX
+ *
+ * STAGNATION_TRIALS = <integer>
+ * The search is stopped if the best tour has not been improved during
+ * the specified number of consecutive trials (counted across runs).
+ * The value 0 disables the stopping rule.
+ * Default: 0
+ *
+ * STATS_FILE = <string>
+ * Specifies the name of a file where statistics are to be written in
+ * JSON format when the program terminates: wall clock times of the main
+ * phases (ReadProblem, CTSP transform, Ascent, GenerateCandidates, trials
+ * and merging), counters (trials, Penalty calls, candidates examined by
+ * SpecialMove, improving 3-opt and 4-opt moves, hash table hits, kicks
+ * and merges), and the peak resident set size. Penalty calls are only
+ * counted if this parameter is given.
+ *
  * SUBGRADIENT = { YES | NO }
  * Specifies whether the Pi-values should be determined by subgradient
  * optimization.
  * Default: YES
  *
+ * TIME_EXTENSION = <real>
+ * If the best tour has been improved during the last quarter of the time
+ * limit when the time limit is reached, the time limit is extended by a
+ * quarter of TIME_LIMIT. The total extension is at most TIME_EXTENSION
+ * seconds.
+ * Default: 0
+ *
  * TIME_LIMIT = <real>
  * Specifies a time limit in seconds for each run.
  * Default: DBL_MAX
@@ -119,6 +287,12 @@
  * Specifies whether time windows are used.
  * Default: YES
  *
+ * TIME_WINDOW_PRUNING = { NO | DEMOTE | DROP }
+ * Specifies how candidate edges are treated that cannot belong to a tour
+ * meeting all time windows (see PruneTimeWindowCandidates.c). DEMOTE
+ * moves these edges to the end of the candidate lists, DROP removes them.
+ * Default: NO
+ *
  * TOUR_FILE = <string>
  * Specifies the name of a file where the best tour is to be written.
  * When a run has produced a new best tour, the tour is written to this file.
@@ -131,6 +305,14 @@
  * the value is the more information is given.
  * Default: 1
  *
+ * ZONE_PRUNING = { NO | DEMOTE | DROP }
+ * Specifies how candidate edges are treated that cannot belong to a tour
+ * satisfying the (super) zone precedence constraints, i.e., edges that
+ * go from a zone to a zone that must precede it. DEMOTE moves these edges
+ * to the end of the candidate lists, DROP removes them (see
+ * PruneZoneCandidates.c).
+ * Default: NO
+ *
  * List of abbreviations
  * ---------------------
  *
@@ -138,10 +320,19 @@
  * if that abbreviation is unambiguous.
  *
  *     Value        Abbreviation
+ *     ALPHA             A
+ *     DEMOTE            D
+ *     DROP              DR
+ *     GPX               G
+ *     HIERARCHICAL      H
+ *     IPT               I
+ *     NEAREST-NEIGHBOR  NE
  *     NO                N
  *     SPECIAL           S
  *     SYMMETRIC         S
+ *     WALK              W
  *     YES               Y
+ *     ZONE              Z
  */
 
 static char Delimiters[] = "= \n\t\r\f\v\xef\xbb\xbf";
@@ -153,16 +344,29 @@ void ReadParameters()
     char *Line, *Keyword, *Token;
     unsigned int i;
 
-    ProblemFileName = TourFileName = 0;
+    ProblemFileName = TourFileName = CheckpointFileName = StatsFileName =
+        ConvergenceFileName = InitialTourFileName = MergeTourFileName = 0;
+    AdaptiveKicking = 0;
     AscentCandidates = 50;
+    BackboneRuns = 0;
+    CandidateSetType = ALPHA;
+    CandidateThreads = 1;
     CandidateSetSymmetric = 0;
+    CheckpointInterval = DBL_MAX;
+    ExactDimension = 12;
     Excess = -1;
     HashingUsed = 1;
     InitialPeriod = -1;
+    InitialTourAlgorithm = WALK;
+    IntraZoneOptimization = 0;
     KickType = 4;
     MaxCandidates = 6;
     MaxTrials = -1;
+    MergeAlgorithm = IPT;
     MergingUsed = 1;
+    MaxPopulationSize = 0;
+    MinImprovementRate = 0;
+    ImprovementRateWindow = 1.0;
     MoveType = 3;
     MoveTypeSpecial = 1;
     MTSPDepot = 1;
@@ -171,10 +375,17 @@ void ReadParameters()
     Precision = 100;
     Runs = 100000;
     Seed = 1;
+    SparseNeighbors = 0;
+    StagnationTime = DBL_MAX;
+    StagnationTrials = 0;
     Subgradient = 1;
+    TimeExtension = 0;
     TimeLimit = DBL_MAX;
+    TimeWindowPruning = NO_PRUNING;
     TimeWindowsUsed = 0;
     TraceLevel = 0;
+    ZoneKick = 0;
+    ZonePruning = NO_PRUNING;
 
     if (ParameterFileName) {
         if (!(ParameterFile = fopen(ParameterFileName, "r")))
@@ -203,14 +414,53 @@ void ReadParameters()
             continue;
         for (i = 0; i < strlen(Keyword); i++)
             Keyword[i] = (char) toupper(Keyword[i]);
-        if (!strcmp(Keyword, "ASCENT_CANDIDATES")) {
+        if (!strcmp(Keyword, "ADAPTIVE_KICKING")) {
+            if (!ReadYesOrNo(&AdaptiveKicking))
+                eprintf("ADAPTIVE_KICKING: YES or NO expected");
+        } else if (!strcmp(Keyword, "ASCENT_CANDIDATES")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &AscentCandidates))
                 eprintf("ASCENT_CANDIDATES: integer expected");
             if (AscentCandidates < 2)
                 eprintf("ASCENT_CANDIDATES: >= 2 expected");
+        } else if (!strcmp(Keyword, "BACKBONE_RUNS")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &BackboneRuns))
+                eprintf("BACKBONE_RUNS: integer expected");
+            if (BackboneRuns < 0)
+                eprintf("BACKBONE_RUNS: non-negative integer expected");
+        } else if (!strcmp(Keyword, "CANDIDATE_SET_TYPE")) {
+            if (!(Token = strtok(0, Delimiters)))
+                eprintf("CANDIDATE_SET_TYPE: string expected");
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strncmp(Token, "ALPHA", strlen(Token)))
+                CandidateSetType = ALPHA;
+            else if (!strncmp(Token, "NEAREST-NEIGHBOR", strlen(Token)))
+                CandidateSetType = NN;
+            else
+                eprintf("CANDIDATE_SET_TYPE: "
+                        "ALPHA or NEAREST-NEIGHBOR expected");
+        } else if (!strcmp(Keyword, "CANDIDATE_THREADS")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &CandidateThreads))
+                eprintf("CANDIDATE_THREADS: integer expected");
+            if (CandidateThreads < 1)
+                eprintf("CANDIDATE_THREADS: positive integer expected");
+        } else if (!strcmp(Keyword, "CHECKPOINT_FILE")) {
+            if (!(CheckpointFileName = GetFileName(0)))
+                eprintf("CHECKPOINT_FILE: string expected");
+        } else if (!strcmp(Keyword, "CHECKPOINT_INTERVAL")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%lf", &CheckpointInterval))
+                eprintf("CHECKPOINT_INTERVAL: real expected");
+            if (CheckpointInterval < 0)
+                eprintf("CHECKPOINT_INTERVAL: >= 0 expected");
         } else if (!strcmp(Keyword, "COMMENT")) {
             continue;
+        } else if (!strcmp(Keyword, "CONVERGENCE_FILE")) {
+            if (!(ConvergenceFileName = GetFileName(0)))
+                eprintf("CONVERGENCE_FILE: string expected");
         } else if (!strcmp(Keyword, "CTSP_TRANSFORM")) {
             if (!ReadYesOrNo(&CTSPTransform))
                 eprintf("CTSP_TRANSFORM: YES or NO expected");
@@ -222,6 +472,12 @@ void ReadParameters()
                 eprintf("DEPOT: positive integer expected");
         } else if (!strcmp(Keyword, "EOF")) {
             break;
+        } else if (!strcmp(Keyword, "EXACT_DIMENSION")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &ExactDimension))
+                eprintf("EXACT_DIMENSION: integer expected");
+            if (ExactDimension < 0 || ExactDimension > 20)
+                eprintf("EXACT_DIMENSION: integer in [0;20] expected");
         } else if (!strcmp(Keyword, "EXCESS")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%lf", &Excess))
@@ -237,12 +493,40 @@ void ReadParameters()
                 eprintf("INITIAL_PERIOD: integer expected");
             if (InitialPeriod < 0)
                 eprintf("INITIAL_PERIOD: non-negative integer expected");
+        } else if (!strcmp(Keyword, "INITIAL_TOUR_ALGORITHM")) {
+            if (!(Token = strtok(0, Delimiters)))
+                eprintf("INITIAL_TOUR_ALGORITHM: string expected");
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strncmp(Token, "WALK", strlen(Token)))
+                InitialTourAlgorithm = WALK;
+            else if (!strncmp(Token, "ZONE", strlen(Token)))
+                InitialTourAlgorithm = ZONE;
+            else if (!strncmp(Token, "HIERARCHICAL", strlen(Token)))
+                InitialTourAlgorithm = HIERARCHICAL;
+            else
+                eprintf("INITIAL_TOUR_ALGORITHM: "
+                        "WALK, ZONE, or HIERARCHICAL expected");
+        } else if (!strcmp(Keyword, "INITIAL_TOUR_FILE")) {
+            if (!(InitialTourFileName = GetFileName(0)))
+                eprintf("INITIAL_TOUR_FILE: string expected");
+        } else if (!strcmp(Keyword, "INTRA_ZONE_OPTIMIZATION")) {
+            if (!ReadYesOrNo(&IntraZoneOptimization))
+                eprintf("INTRA_ZONE_OPTIMIZATION: YES or NO expected");
         } else if (!strcmp(Keyword, "KICK_TYPE")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &KickType))
                 eprintf("KICK_TYPE: integer expected");
             if (KickType != 0 && KickType < 4)
                 eprintf("KICK_TYPE: integer >= 4 expected");
+            if ((Token = strtok(0, Delimiters))) {
+                for (i = 0; i < strlen(Token); i++)
+                    Token[i] = (char) toupper(Token[i]);
+                if (!strncmp(Token, "ZONE", strlen(Token)))
+                    ZoneKick = 1;
+                else
+                    eprintf("(KICK_TYPE) Illegal ZONE specification");
+            }
         } else if (!strcmp(Keyword, "MAX_CANDIDATES")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &MaxCandidates))
@@ -264,9 +548,36 @@ void ReadParameters()
                 eprintf("MAX_TRIALS: integer expected");
             if (MaxTrials < 0)
                 eprintf("MAX_TRIALS: non-negative integer expected");
+        } else if (!strcmp(Keyword, "MERGE_ALGORITHM")) {
+            if (!(Token = strtok(0, Delimiters)))
+                eprintf("MERGE_ALGORITHM: string expected");
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strncmp(Token, "IPT", strlen(Token)))
+                MergeAlgorithm = IPT;
+            else if (!strncmp(Token, "GPX", strlen(Token)))
+                MergeAlgorithm = GPX;
+            else
+                eprintf("MERGE_ALGORITHM: IPT or GPX expected");
+        } else if (!strcmp(Keyword, "MERGE_TOUR_FILE")) {
+            if (!(MergeTourFileName = GetFileName(0)))
+                eprintf("MERGE_TOUR_FILE: string expected");
         } else if (!strcmp(Keyword, "MERGING")) {
             if (!ReadYesOrNo(&MergingUsed))
                 eprintf("MERGING: YES or NO expected");
+        } else if (!strcmp(Keyword, "MIN_IMPROVEMENT_RATE")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%lf", &MinImprovementRate))
+                eprintf("MIN_IMPROVEMENT_RATE: real expected");
+            if (MinImprovementRate < 0)
+                eprintf("MIN_IMPROVEMENT_RATE: >= 0 expected");
+            if ((Token = strtok(0, Delimiters)) && Token[0] != '#') {
+                if (!sscanf(Token, "%lf", &ImprovementRateWindow))
+                    eprintf("MIN_IMPROVEMENT_RATE: real expected");
+                if (ImprovementRateWindow <= 0)
+                    eprintf("MIN_IMPROVEMENT_RATE: "
+                            "positive window expected");
+            }
         } else if (!strcmp(Keyword, "MOVE_TYPE")) {
              if (!(Token = strtok(0, Delimiters)) ||
                  !sscanf(Token, "%d", &MoveType))
@@ -278,6 +589,12 @@ void ReadParameters()
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &PenaltyMultiplier))
                 eprintf("PENALTY_MULTIPLIER: integer expected");
+        } else if (!strcmp(Keyword, "POPULATION_SIZE")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &MaxPopulationSize))
+                eprintf("POPULATION_SIZE: integer expected");
+            if (MaxPopulationSize < 0)
+                eprintf("POPULATION_SIZE: non-negative integer expected");
         } else if (!strcmp(Keyword, "PRECISION")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &Precision))
@@ -295,15 +612,55 @@ void ReadParameters()
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%u", &Seed))
                 eprintf("SEED: integer expected");
+        } else if (!strcmp(Keyword, "SPARSE_NEIGHBORS")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &SparseNeighbors))
+                eprintf("SPARSE_NEIGHBORS: integer expected");
+            if (SparseNeighbors < 0)
+                eprintf("SPARSE_NEIGHBORS: non-negative integer expected");
+        } else if (!strcmp(Keyword, "STAGNATION_TIME")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%lf", &StagnationTime))
+                eprintf("STAGNATION_TIME: real expected");
+            if (StagnationTime < 0)
+                eprintf("STAGNATION_TIME: >= 0 expected");
+        } else if (!strcmp(Keyword, "STAGNATION_TRIALS")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%d", &StagnationTrials))
+                eprintf("STAGNATION_TRIALS: integer expected");
+            if (StagnationTrials < 0)
+                eprintf("STAGNATION_TRIALS: non-negative integer expected");
+        } else if (!strcmp(Keyword, "STATS_FILE")) {
+            if (!(StatsFileName = GetFileName(0)))
+                eprintf("STATS_FILE: string expected");
         } else if (!strcmp(Keyword, "SUBGRADIENT")) {
             if (!ReadYesOrNo(&Subgradient))
                 eprintf("SUBGRADIENT: YES or NO expected");
+        } else if (!strcmp(Keyword, "TIME_EXTENSION")) {
+            if (!(Token = strtok(0, Delimiters)) ||
+                !sscanf(Token, "%lf", &TimeExtension))
+                eprintf("TIME_EXTENSION: real expected");
+            if (TimeExtension < 0)
+                eprintf("TIME_EXTENSION: >= 0 expected");
         } else if (!strcmp(Keyword, "TIME_LIMIT")) {
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%lf", &TimeLimit))
                 eprintf("TIME_LIMIT: real expected");
             if (TimeLimit < 0)
                 eprintf("TIME_LIMIT: >= 0 expected");
+        } else if (!strcmp(Keyword, "TIME_WINDOW_PRUNING")) {
+            if (!(Token = strtok(0, Delimiters)))
+                eprintf("TIME_WINDOW_PRUNING: string expected");
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strncmp(Token, "NO", strlen(Token)))
+                TimeWindowPruning = NO_PRUNING;
+            else if (!strncmp(Token, "DEMOTE", strlen(Token)))
+                TimeWindowPruning = DEMOTE;
+            else if (!strncmp(Token, "DROP", strlen(Token)))
+                TimeWindowPruning = DROP;
+            else
+                eprintf("TIME_WINDOW_PRUNING: NO, DEMOTE, or DROP expected");
         } else if (!strcmp(Keyword, "TIME_WINDOWS")) {
             if (!ReadYesOrNo(&TimeWindowsUsed))
                 eprintf("TIME_WINDOWS: YES or NO expected");
@@ -314,6 +671,19 @@ void ReadParameters()
             if (!(Token = strtok(0, Delimiters)) ||
                 !sscanf(Token, "%d", &TraceLevel))
                 eprintf("TRACE_LEVEL: integer expected");
+        } else if (!strcmp(Keyword, "ZONE_PRUNING")) {
+            if (!(Token = strtok(0, Delimiters)))
+                eprintf("ZONE_PRUNING: string expected");
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strncmp(Token, "NO", strlen(Token)))
+                ZonePruning = NO_PRUNING;
+            else if (!strncmp(Token, "DEMOTE", strlen(Token)))
+                ZonePruning = DEMOTE;
+            else if (!strncmp(Token, "DROP", strlen(Token)))
+                ZonePruning = DROP;
+            else
+                eprintf("ZONE_PRUNING: NO, DEMOTE, or DROP expected");
         } else
             eprintf("Unknown keyword: %s", Keyword);
         if ((Token = strtok(0, Delimiters)) && Token[0] != '#')
@@ -321,6 +691,8 @@ void ReadParameters()
     }
     if (!ProblemFileName)
         eprintf("Problem file name is missing");
+    if (MergeTourFileName && !InitialTourFileName)
+        eprintf("MERGE_TOUR_FILE: INITIAL_TOUR_FILE is missing");
     fclose(ParameterFile);
     free(LastLine);
     LastLine = 0;
@@ -97,6 +97,16 @@
  * Contains a list of possible alternate depot nodes. This list is terminated
  * by a -1. The current implementation allows only one depot.
  *
+ * NODE_COORD_SECTION :
+ * Node coordinates are given in this section. Each line is of the form
+ *
+ *      <integer> <real> <real>
+ *
+ * The integer specifies a node number, the reals its latitude and
+ * longitude in degrees. The coordinates are optional. They are only used
+ * for estimating the costs that are not stored when SPARSE_NEIGHBORS is
+ * positive (see Distance_SPARSE).
+ *
  * GTSP_SET_SECTION :
  * This section defines which nodes belong to which clusters. This section
  * contains exactly M entries, where M is the number of clusters.
@@ -130,6 +140,7 @@ static void Read_FIXED_EDGES_SECTION(void);
 static void Read_GTSP_SETS(void);
 static void Read_GTSP_SET_SECTION(void);
 static void Read_NAME(void);
+static void Read_NODE_COORD_SECTION(void);
 static void Read_SERVICE_TIME(void);
 static void Read_SERVICE_TIME_SECTION(void);
 static void Read_SUPER_GTSP_SETS(void);
@@ -143,11 +154,20 @@ static void Read_SUPER_SUPER_ZONE_NEIGHBOR_SECTION(void);
 static void Read_SUPER_SUPER_ZONE_PATH_SECTION(void);
 static void Read_SUPER_SUPER_ZONE_PRECEDENCE_SECTION(void);
 static void Read_TIME_WINDOW_SECTION(void);
+static void Read_TOUR_SECTION(FILE ** File);
 static void Read_TYPE(void);
 static void Read_ZONE_NEIGHBOR_SECTION(void);
 static void Read_ZONE_PATH_SECTION(void);
 static void Read_ZONE_PRECEDENCE_SECTION(void);
 static void Read_ZONE_SECTION(ZoneConstraint ** First, char * SectionName);
+static void ReadSparseWeights(void);
+static void KeepSparse(Node * N, int Id, int W, int k);
+static void SortSparse(Node * N);
+static void FitSparseScale(void);
+
+static int CoordinatesGiven;
+
+#define PI 3.14159265358979323846
 
 void ReadProblem()
 {
@@ -165,6 +185,7 @@ void ReadProblem()
     Distance = 0;
     C = 0;
     c = 0;
+    CoordinatesGiven = 0;
     while ((Line = ReadLine(ProblemFile))) {
         if (!(Keyword = strtok(Line, Delimiters)))
             continue;
@@ -191,6 +212,8 @@ void ReadProblem()
             Read_GTSP_SET_SECTION();
         else if (!strcmp(Keyword, "NAME"))
             Read_NAME();
+        else if (!strcmp(Keyword, "NODE_COORD_SECTION"))
+            Read_NODE_COORD_SECTION();
         else if (!strcmp(Keyword, "SERVICE_TIME"))
             Read_SERVICE_TIME();
         else if (!strcmp(Keyword, "SERVICE_TIME_SECTION"))
@@ -229,6 +252,8 @@ void ReadProblem()
             eprintf("Unknown keyword: %s", Keyword);
     }
     Swaps = 0;
+    if (Distance == Distance_SPARSE)
+        FitSparseScale();
 
     /* Adjust parameters */
     if (Seed == 0)
@@ -264,7 +289,7 @@ void ReadProblem()
     }
     if (CostMatrix == 0 && Dimension <= MaxMatrixDimension &&
         Distance != 0 && Distance != Distance_EXPLICIT &&
-        Distance != Distance_ATSP) {
+        Distance != Distance_ATSP && Distance != Distance_SPARSE) {
         Node *Ni, *Nj;
         CostMatrix = (int *) calloc((size_t) Dim * (Dim - 1) / 2, sizeof(int));
         Ni = FirstNode->Suc;
@@ -291,7 +316,9 @@ void ReadProblem()
                 if (N->C[j] * Precision / Precision != N->C[j])
                     eprintf("PRECISION (= %d) is too large", Precision);
         }
-    }
+    } else if (Precision > 1 && Distance == Distance_SPARSE &&
+               M * Precision / Precision != M)
+        eprintf("PRECISION (= %d) is too large", Precision);
     if (TraceLevel >= 1) {
         printff("done\n");
         PrintParameters();
@@ -299,6 +326,8 @@ void ReadProblem()
     fclose(ProblemFile);
     if (InitialTourFileName)
         ReadTour(InitialTourFileName, &InitialTourFile);
+    if (MergeTourFileName)
+        ReadTour(MergeTourFileName, &MergeTourFile);
     free(LastLine);
     LastLine = 0;
 }
@@ -370,6 +399,39 @@ static void Read_NAME()
         eprintf("NAME: string expected");
 }
 
+static void Read_NODE_COORD_SECTION()
+{
+    int Id, i;
+    Node *N;
+
+    CheckSpecificationPart();
+    if (!FirstNode)
+        CreateNodes();
+    N = FirstNode;
+    do
+        N->V = 0;
+    while ((N = N->Suc) != FirstNode);
+    for (i = 1; i <= Dim; i++) {
+        if (!fscanint(ProblemFile, &Id))
+            eprintf("NODE_COORD_SECTION: Missing nodes");
+        if (Id <= 0 || Id > Dim)
+            eprintf("NODE_COORD_SECTION: Node number out of range: %d", Id);
+        N = &NodeSet[Id];
+        if (N->V == 1)
+            eprintf("NODE_COORD_SECTION: Node number occurs twice: %d",
+                    N->Id);
+        N->V = 1;
+        if (!fscanf(ProblemFile, "%lf", &N->Lat))
+            eprintf("NODE_COORD_SECTION: Missing latitude");
+        if (!fscanf(ProblemFile, "%lf", &N->Lng))
+            eprintf("NODE_COORD_SECTION: Missing longitude");
+        N->Lat *= PI / 180;
+        N->Lng *= PI / 180;
+        N->CosLat = cos(N->Lat);
+    }
+    CoordinatesGiven = 1;
+}
+
 static void Read_DEPOT_SECTION()
 {
     int i;
@@ -416,29 +478,162 @@ static void Read_EDGE_WEIGHT_SECTION()
     if (!FirstNode)
         CreateNodes();
     n = Dimension / 2;
-    CostMatrix = (int *) calloc((size_t) n * n, sizeof(int));
-    for (Ni = FirstNode; Ni->Id <= n; Ni = Ni->Suc)
-        Ni->C = &CostMatrix[(size_t) (Ni->Id - 1) * n] - 1;
-    switch (WeightFormat) {
-    case FULL_MATRIX:
-        for (i = 1; i <= Dim; i++) {
-            Ni = &NodeSet[i];
-            for (j = 1; j <= Dim; j++) {
-                if (!fscanf(ProblemFile, "%d", &W))
-                    eprintf("EDGE_WEIGHT_SECTION: Missing weight");
-                Ni->C[j] = W;
-                if (j != i && W > M)
-                    M = W;
+    if (SparseNeighbors == 0 && n > MaxMatrixDimension)
+        SparseNeighbors = 50;
+    if (SparseNeighbors > 0 && SparseNeighbors < n - 1) {
+        ReadSparseWeights();
+        Distance = Distance_SPARSE;
+    } else {
+        CostMatrix = (int *) calloc((size_t) n * n, sizeof(int));
+        for (Ni = FirstNode; Ni->Id <= n; Ni = Ni->Suc)
+            Ni->C = &CostMatrix[(size_t) (Ni->Id - 1) * n] - 1;
+        switch (WeightFormat) {
+        case FULL_MATRIX:
+            for (i = 1; i <= Dim; i++) {
+                Ni = &NodeSet[i];
+                for (j = 1; j <= Dim; j++) {
+                    if (!fscanf(ProblemFile, "%d", &W))
+                        eprintf("EDGE_WEIGHT_SECTION: Missing weight");
+                    Ni->C[j] = W;
+                    if (j != i && W > M)
+                        M = W;
+                }
             }
+            break;
         }
-        break;
+        Distance = Distance_ATSP;
     }
     for (i = 1; i <= DimensionSaved; i++)
         FixEdge(&NodeSet[i], &NodeSet[i + DimensionSaved]);
-    Distance = Distance_ATSP;
     WeightType = -1;
 }
 
+/*
+ * The ReadSparseWeights function reads the FULL_MATRIX row by row, but
+ * stores only the costs of the k = SPARSE_NEIGHBORS nearest successors
+ * and the k nearest predecessors of each node, so that O(n * k) memory is
+ * used instead of O(n * n). The costs from node i are stored in the
+ * sparse list of node i, and the costs to node j are stored in the sparse
+ * list of Twin(j). Each list is sorted by node number (see
+ * Distance_SPARSE). The mean of the costs of each list that are not
+ * stored is recorded in SparseMean.
+ */
+
+static void ReadSparseWeights()
+{
+    Node *Ni;
+    int n = Dimension / 2, k = SparseNeighbors, i, j, W;
+    long long *Sum = (long long *) calloc(Dimension + 1, sizeof(long long));
+
+    for (i = 1; i <= Dimension; i++) {
+        Ni = &NodeSet[i];
+        Ni->SparseId = (int *) malloc(k * sizeof(int));
+        Ni->SparseCost = (int *) malloc(k * sizeof(int));
+        Ni->SparseCount = 0;
+    }
+    for (i = 1; i <= Dim; i++) {
+        Ni = &NodeSet[i];
+        for (j = 1; j <= Dim; j++) {
+            if (!fscanf(ProblemFile, "%d", &W))
+                eprintf("EDGE_WEIGHT_SECTION: Missing weight");
+            if (j == i)
+                continue;
+            if (W > M)
+                M = W;
+            KeepSparse(Ni, j, W, k);
+            KeepSparse(&NodeSet[j + n], i, W, k);
+            Sum[i] += W;
+            Sum[j + n] += W;
+        }
+    }
+    for (i = 1; i <= Dimension; i++) {
+        Ni = &NodeSet[i];
+        SortSparse(Ni);
+        for (j = 0; j < Ni->SparseCount; j++)
+            Sum[i] -= Ni->SparseCost[j];
+        Ni->SparseMean = Ni->SparseCount < Dim - 1 ?
+            (int) ((Sum[i] + (Dim - 1 - Ni->SparseCount) / 2) /
+                   (Dim - 1 - Ni->SparseCount)) : Ni->SparseMax;
+    }
+    free(Sum);
+}
+
+/*
+ * The KeepSparse function adds the cost W for node Id to the sparse list
+ * of node N, if the list has fewer than k entries, or if W is less than
+ * its largest cost, which is then replaced.
+ */
+
+static void KeepSparse(Node * N, int Id, int W, int k)
+{
+    int i;
+
+    if (N->SparseCount < k) {
+        if (N->SparseCount == 0 || W > N->SparseMax)
+            N->SparseMax = W;
+        N->SparseId[N->SparseCount] = Id;
+        N->SparseCost[N->SparseCount++] = W;
+        return;
+    }
+    if (W >= N->SparseMax)
+        return;
+    for (i = 0; N->SparseCost[i] != N->SparseMax; i++);
+    N->SparseId[i] = Id;
+    N->SparseCost[i] = W;
+    for (N->SparseMax = W, i = 0; i < k; i++)
+        if (N->SparseCost[i] > N->SparseMax)
+            N->SparseMax = N->SparseCost[i];
+}
+
+/*
+ * The SortSparse function sorts the sparse list of node N by node number
+ * (insertion sort).
+ */
+
+static void SortSparse(Node * N)
+{
+    int i, j, Id, W;
+
+    for (i = 1; i < N->SparseCount; i++) {
+        Id = N->SparseId[i];
+        W = N->SparseCost[i];
+        for (j = i; j > 0 && N->SparseId[j - 1] > Id; j--) {
+            N->SparseId[j] = N->SparseId[j - 1];
+            N->SparseCost[j] = N->SparseCost[j - 1];
+        }
+        N->SparseId[j] = Id;
+        N->SparseCost[j] = W;
+    }
+}
+
+/*
+ * The FitSparseScale function determines SparseScale, the factor used by
+ * Distance_SPARSE for converting great circle distances to costs. The
+ * factor is fitted to the stored costs by least squares (regression
+ * through the origin). SparseScale is 0 if no coordinates have been given.
+ */
+
+static void FitSparseScale()
+{
+    Node *Ni;
+    double Sxy = 0, Sxx = 0, X;
+    int i, j;
+
+    SparseScale = 0;
+    if (!CoordinatesGiven)
+        return;
+    for (i = 1; i <= DimensionSaved; i++) {
+        Ni = &NodeSet[i];
+        for (j = 0; j < Ni->SparseCount; j++) {
+            X = GreatCircleDistance(Ni, &NodeSet[Ni->SparseId[j]]);
+            Sxy += X * Ni->SparseCost[j];
+            Sxx += X * X;
+        }
+    }
+    if (Sxx > 0)
+        SparseScale = Sxy / Sxx;
+}
+
 static void Read_EDGE_WEIGHT_TYPE()
 {
     unsigned int i;
@@ -905,11 +1100,6 @@ static void Read_TYPE()
  
  The format is as follows:
  
- OPTIMUM = <real>
- Known optimal tour length. A run will be terminated as soon as a tour
- length less than or equal to optimum is achieved.
- Default: MINUS_INFINITY.
- 
  TOUR_SECTION :
  A tour is specified in this section. The tour is given by a list of integers
  giving the sequence in which the nodes are visited in the tour. The tour is
@@ -920,6 +1110,11 @@ static void Read_TYPE()
  
  Other keywords in TSPLIB format may be included in the file, but they are
  ignored.
+
+ The tour is recorded in the InitialSuc field of each node if File is
+ &InitialTourFile; otherwise, in the MergeSuc field. If the problem has
+ been transformed into a symmetric one, the tour is recorded in the
+ transformed problem, where each node is preceded by its twin.
  */
 
 void ReadTour(char *FileName, FILE ** File)
@@ -958,6 +1153,9 @@ void ReadTour(char *FileName, FILE ** File)
                     ("[%s] (DIMENSION): does not match problem dimension",
                      FileName);
             }
+        } else if (!strcmp(Keyword, "TOUR_SECTION")) {
+            Read_TOUR_SECTION(File);
+            Done = 1;
         } else if (!strcmp(Keyword, "EOF"))
             break;
         else
@@ -967,3 +1165,51 @@ void ReadTour(char *FileName, FILE ** File)
         eprintf("Missing TOUR_SECTION in tour file: \"%s\"", FileName);
     fclose(*File);
 }
+
+static void Read_TOUR_SECTION(FILE ** File)
+{
+    Node *First = 0, *Last = 0, *N, *Twin;
+    int i, Count = 0;
+
+    N = FirstNode;
+    do
+        N->V = 0;
+    while ((N = N->Suc) != FirstNode);
+    if (!fscanint(*File, &i))
+        i = -1;
+    while (i != -1) {
+        if (i <= 0 || i > DimensionSaved)
+            eprintf("TOUR_SECTION: Node number out of range: %d", i);
+        N = &NodeSet[i];
+        if (N->V)
+            eprintf("TOUR_SECTION: Node number occurs twice: %d", i);
+        N->V = 1;
+        Count++;
+        if (!First)
+            First = N;
+        else if (Dimension != DimensionSaved) {
+            Twin = &NodeSet[i + DimensionSaved];
+            Last->Next = Twin;
+            Twin->Next = N;
+        } else
+            Last->Next = N;
+        Last = N;
+        if (!fscanint(*File, &i))
+            i = -1;
+    }
+    if (Count != DimensionSaved)
+        eprintf("TOUR_SECTION: Too few nodes: %d", Count);
+    if (Dimension != DimensionSaved) {
+        Twin = &NodeSet[First->Id + DimensionSaved];
+        Last->Next = Twin;
+        Twin->Next = First;
+    } else
+        Last->Next = First;
+    N = First;
+    do {
+        if (File == &InitialTourFile)
+            N->InitialSuc = N->Next;
+        else
+            N->MergeSuc = N->Next;
+    } while ((N = N->Next) != First);
+}
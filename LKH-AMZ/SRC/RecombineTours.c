@@ -0,0 +1,126 @@
+#include "LKH.h"
+
+/*
+ * The RecombineTours function recombines two tours of the problem: the
+ * tour given by INITIAL_TOUR_FILE, T1, and the tour given by
+ * MERGE_TOUR_FILE, T2. The two tours may have been found for different
+ * variants of the problem, but both are evaluated with the penalty of
+ * the problem at hand.
+ *
+ * First, T1 and T2 are merged by the MergeWithTour function (iterative
+ * partial transcription), or by the MergeWithTourGPX function if
+ * MERGE_ALGORITHM is GPX. Then the merged tour is used as the initial
+ * tour of a single call of FindTour, which attempts to improve it by at
+ * most MAX_TRIALS trials.
+ *
+ * The resulting tour is recorded in BestTour, and its cost and objective
+ * value are recorded in BestCost and BestPenalty. The function returns 1
+ * if the tour dominates both T1 and T2; otherwise 0. A tour dominates
+ * another tour if neither its penalty nor its cost exceeds that of the
+ * other tour, and the two tours differ in penalty or cost.
+ */
+
+static void EvaluateTours(long long *Penalty1, long long *Cost1,
+                          long long *Penalty2, long long *Cost2);
+static long long TourCost(void);
+static int Dominates(long long Penalty1, long long Cost1,
+                     long long Penalty2, long long Cost2);
+
+int RecombineTours()
+{
+    long long Cost, Cost1, Cost2, Penalty1, Penalty2;
+    Node *N = FirstNode;
+
+    EvaluateTours(&Penalty1, &Cost1, &Penalty2, &Cost2);
+    Cost = (MergeAlgorithm == GPX ? MergeWithTourGPX() : MergeWithTour()) -
+        GTSPSets * MM;
+    if (TraceLevel >= 1)
+        printff("Merged: Cost = %lld_%lld\n", CurrentPenalty, Cost);
+    if (MaxTrials > 0) {
+        /* Use the merged tour as initial tour */
+        do
+            N->InitialSuc = N->Suc;
+        while ((N = N->Suc) != FirstNode);
+        Run = 1;
+        Cost = FindTour() - GTSPSets * MM;
+        if (TraceLevel >= 1)
+            printff("Improved: Cost = %lld_%lld\n", CurrentPenalty, Cost);
+    }
+    RecordBetterTour();
+    RecordBestTour();
+    WriteConvergence('G', CurrentPenalty, Cost);
+    BestCost = Cost;
+    BestPenalty = PenaltyMultiplier * CurrentPenalty + Cost;
+    return Dominates(CurrentPenalty, Cost, Penalty1, Cost1) &&
+        Dominates(CurrentPenalty, Cost, Penalty2, Cost2);
+}
+
+/*
+ * The DominatesInputTours function returns 1 if a tour with the given
+ * penalty and cost dominates both T1 and T2; otherwise 0. It is used
+ * when the problem has been solved without recombination (by SolveExactly
+ * or by the ascent). The current tour (the Suc pointers) is destroyed.
+ */
+
+int DominatesInputTours(long long Penalty, long long Cost)
+{
+    long long Cost1, Cost2, Penalty1, Penalty2;
+
+    EvaluateTours(&Penalty1, &Cost1, &Penalty2, &Cost2);
+    return Dominates(Penalty, Cost, Penalty1, Cost1) &&
+        Dominates(Penalty, Cost, Penalty2, Cost2);
+}
+
+/*
+ * EvaluateTours computes the penalties and costs of T1 and T2. On return,
+ * the Suc pointers represent T1, and the Next pointers represent T2.
+ */
+
+static void EvaluateTours(long long *Penalty1, long long *Cost1,
+                          long long *Penalty2, long long *Cost2)
+{
+    Node *N = FirstNode;
+
+    /* Evaluate T2 */
+    do
+        (N->Suc = N->MergeSuc)->Pred = N;
+    while ((N = N->Suc) != FirstNode);
+    *Cost2 = TourCost();
+    CurrentPenalty = LLONG_MAX;
+    *Penalty2 = Penalty();
+
+    /* Evaluate T1, and let the Next pointers represent T2 */
+    do {
+        (N->Suc = N->InitialSuc)->Pred = N;
+        N->Next = N->MergeSuc;
+    } while ((N = N->Suc) != FirstNode);
+    *Cost1 = TourCost();
+    CurrentPenalty = LLONG_MAX;
+    *Penalty1 = Penalty();
+    if (TraceLevel >= 1) {
+        printff("Tour 1: Cost = %lld_%lld\n", *Penalty1, *Cost1);
+        printff("Tour 2: Cost = %lld_%lld\n", *Penalty2, *Cost2);
+    }
+}
+
+/*
+ * TourCost returns the cost of the tour given by the Suc pointers.
+ */
+
+static long long TourCost()
+{
+    long long Cost = 0;
+    Node *N = FirstNode;
+
+    do
+        Cost += C(N, N->Suc) - N->Pi - N->Suc->Pi;
+    while ((N = N->Suc) != FirstNode);
+    return Cost / Precision - GTSPSets * MM;
+}
+
+static int Dominates(long long Penalty1, long long Cost1,
+                     long long Penalty2, long long Cost2)
+{
+    return Penalty1 <= Penalty2 && Cost1 <= Cost2 &&
+        (Penalty1 < Penalty2 || Cost1 < Cost2);
+}
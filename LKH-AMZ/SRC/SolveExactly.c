@@ -0,0 +1,207 @@
+#include "LKH.h"
+
+/*
+ * The SolveExactly function finds an optimal tour of a small instance,
+ * that is, a tour that minimizes PENALTY_MULTIPLIER * penalty + cost.
+ * The function is called from LKHmain instead of the Lin-Kernighan
+ * heuristic when the number of nodes does not exceed EXACT_DIMENSION.
+ *
+ * First, the Held-Karp dynamic programming recursion computes, for each
+ * subset S of the nodes other than the depot and each node j in S, the
+ * minimum cost, Rest[S][j], of a path that starts at j, visits all nodes
+ * of S, and ends at the depot. Next, the tours are enumerated by a
+ * depth-first search from the depot. A partial tour ending at node j is
+ * abandoned when its cost plus the cost of the cheapest completion (the
+ * Rest value of the unvisited nodes) is not less than the objective of
+ * the best tour found so far. Since the penalty is non-negative, this
+ * bound is valid. The successors of a node are tried in order of
+ * increasing bound, so the first complete tour is a minimum cost tour.
+ * The penalty of each complete tour is computed by the Penalty function.
+ *
+ * On return, the optimal tour is held in Suc, and its penalty in
+ * CurrentPenalty. The function returns the cost of the tour (including
+ * the transformation constants GTSPSets * MM). If the instance is not an
+ * ATSP instance, if it contains fixed edges (other than the edges of the
+ * ATSP transformation), or if the search exceeds MaxSearchNodes nodes,
+ * the function returns LLONG_MAX.
+ */
+
+#define Twin(N) (&NodeSet[(N)->Id + DimensionSaved])
+#define MaxSearchNodes 10000000
+
+static int n;                   /* Number of nodes other than the depot */
+static Node **Stop;             /* Stop[0..n-1]: the nodes other than the
+                                   depot */
+static long long **Cost;        /* Cost[i][j]: cost of going from Stop[i]
+                                   to Stop[j] (n: the depot) */
+static long long *Rest;         /* Rest[S * n + j], see above */
+static int *Sequence, *BestSequence;
+static long long BestObjective, SearchNodes;
+
+static void BuildTour(int *Sequence);
+static void Search(int Depth, int Last, unsigned Unvisited,
+                   long long CostSoFar);
+static long long TourPenalty(int *Sequence, long long TourCost);
+
+long long SolveExactly()
+{
+    Node *N;
+    unsigned S, Full;
+    long long Min, c, TourCost = 0;
+    int i, j, k;
+
+    if (Dimension != 2 * DimensionSaved ||
+        (Distance != Distance_ATSP && Distance != Distance_SPARSE))
+        return LLONG_MAX;
+    for (i = 1; i <= DimensionSaved; i++) {
+        N = &NodeSet[i];
+        if ((N->FixedTo1 && N->FixedTo1 != Twin(N)) ||
+            (N->FixedTo2 && N->FixedTo2 != Twin(N)))
+            return LLONG_MAX;
+    }
+    n = DimensionSaved - 1;
+    Stop = (Node **) malloc((n + 1) * sizeof(Node *));
+    for (i = 1, k = 0; i <= DimensionSaved; i++)
+        if (&NodeSet[i] != Depot)
+            Stop[k++] = &NodeSet[i];
+    Stop[n] = Depot;
+    Cost = (long long **) malloc((n + 1) * sizeof(long long *));
+    for (i = 0; i <= n; i++) {
+        Cost[i] = (long long *) malloc((n + 1) * sizeof(long long));
+        for (j = 0; j <= n; j++)
+            Cost[i][j] = i == j ? 0 : Distance(Stop[i], Twin(Stop[j]));
+    }
+
+    /* Held-Karp: Rest[S][j] for all S and all j in S */
+    Full = (1U << n) - 1;
+    Rest = (long long *) malloc((size_t) (Full + 1) * n * sizeof(long long));
+    for (S = 1; S <= Full; S++) {
+        for (j = 0; j < n; j++) {
+            if (!(S & (1U << j)))
+                continue;
+            if (S == (1U << j)) {
+                Rest[S * n + j] = Cost[j][n];
+                continue;
+            }
+            Min = LLONG_MAX;
+            for (k = 0; k < n; k++)
+                if (k != j && (S & (1U << k)) &&
+                    (c = Cost[j][k] + Rest[(S ^ (1U << j)) * n + k]) < Min)
+                    Min = c;
+            Rest[S * n + j] = Min;
+        }
+    }
+
+    /* Depth-first branch and bound */
+    Sequence = (int *) malloc(n * sizeof(int));
+    BestSequence = (int *) malloc(n * sizeof(int));
+    BestObjective = LLONG_MAX;
+    SearchNodes = 0;
+    Search(0, n, Full, 0);
+
+    if (SearchNodes <= MaxSearchNodes) {
+        BuildTour(BestSequence);
+        for (i = 0, j = n; i < n; j = BestSequence[i++])
+            TourCost += Cost[j][BestSequence[i]];
+        TourCost += Cost[j][n];
+        CurrentPenalty = LLONG_MAX;
+        CurrentPenalty = Penalty();
+        if (TraceLevel >= 1)
+            printff("Exact solution: Cost = %lld_%lld, Nodes = %lld\n",
+                    PenaltyMultiplier * CurrentPenalty + TourCost -
+                    GTSPSets * MM, TourCost - GTSPSets * MM, SearchNodes);
+    }
+
+    for (i = 0; i <= n; i++)
+        free(Cost[i]);
+    free(Cost);
+    free(Rest);
+    free(Stop);
+    free(Sequence);
+    free(BestSequence);
+    return SearchNodes <= MaxSearchNodes ? TourCost : LLONG_MAX;
+}
+
+/*
+ * The Search function extends the partial tour Sequence[0..Depth-1],
+ * which ends at Stop[Last] and has cost CostSoFar, in all promising ways.
+ */
+
+static void Search(int Depth, int Last, unsigned Unvisited,
+                   long long CostSoFar)
+{
+    long long Bound[32], Objective;
+    int Next[32], Count = 0, i, j, k;
+
+    if (++SearchNodes > MaxSearchNodes)
+        return;
+    if (Unvisited == 0) {
+        CostSoFar += Cost[Last][n];
+        Objective = CostSoFar + PenaltyMultiplier *
+            TourPenalty(Sequence, CostSoFar);
+        if (Objective < BestObjective) {
+            BestObjective = Objective;
+            memcpy(BestSequence, Sequence, n * sizeof(int));
+        }
+        return;
+    }
+    for (k = 0; k < n; k++) {
+        if (!(Unvisited & (1U << k)))
+            continue;
+        Bound[Count] = CostSoFar + Cost[Last][k] + Rest[Unvisited * n + k];
+        if (Bound[Count] >= BestObjective)
+            continue;
+        /* Insertion sort by increasing bound */
+        for (i = Count; i > 0 && Bound[i - 1] > Bound[Count]; i--);
+        for (j = Count; j > i; j--) {
+            Bound[j] = Bound[j - 1];
+            Next[j] = Next[j - 1];
+        }
+        Bound[i] = CostSoFar + Cost[Last][k] + Rest[Unvisited * n + k];
+        Next[i] = k;
+        Count++;
+    }
+    for (i = 0; i < Count && Bound[i] < BestObjective; i++) {
+        k = Next[i];
+        Sequence[Depth] = k;
+        Search(Depth + 1, k, Unvisited ^ (1U << k),
+               CostSoFar + Cost[Last][k]);
+    }
+}
+
+/*
+ * The TourPenalty function returns the penalty of the tour that visits
+ * the nodes in the order given by Sequence and has the given cost. The
+ * penalty is only computed in full if the tour can beat the best tour
+ * found so far.
+ */
+
+static long long TourPenalty(int *Sequence, long long TourCost)
+{
+    BuildTour(Sequence);
+    CurrentPenalty = BestObjective == LLONG_MAX || PenaltyMultiplier <= 0 ?
+        LLONG_MAX : (BestObjective - TourCost) / PenaltyMultiplier;
+    return Penalty();
+}
+
+/*
+ * The BuildTour function builds the tour that visits the nodes in the
+ * order given by Sequence in Suc and Pred: Depot, Twin(N1), N1, ...,
+ * Twin(Depot).
+ */
+
+static void BuildTour(int *Sequence)
+{
+    Node *N, *Last = Depot;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        N = Stop[Sequence[i]];
+        Link(Last, Twin(N));
+        Link(Twin(N), N);
+        Last = N;
+    }
+    Link(Last, Twin(Depot));
+    Link(Twin(Depot), Depot);
+    Reversed = 0;
+}
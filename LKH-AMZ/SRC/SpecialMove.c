@@ -7,13 +7,17 @@
  * or a non-sequential 4-move, that improves the tour.
  *
  * The function is called from the LinKernighan function.
+ *
+ * The number of candidate edges examined is added to
+ * Stats.SpecialMoveCandidates once per call (not in the loops below); it
+ * is derived from the positions reached in the candidate sets.
  */
 
 void SpecialMove(Node * t1, Node * t2, long long * G0, long long * Gain)
 {
     Node *t3, *t4, *t5 = 0, *t6 = 0, *t7 = 0, *t8 = 0, *t6Old = 0, *t7Old = 0;
     Candidate *Nt2, *Nt4;
-    long long G1, G2, G3, G4;
+    long long G1, G2, G3, G4, Examined = 0;
     int Case56, Case78;
 
     if (t2 != SUC(t1))
@@ -25,6 +29,8 @@ void SpecialMove(Node * t1, Node * t2, long long * G0, long long * Gain)
             (G1 = *G0 - Nt2->Cost) <= 0)
             continue;
         t4 = SUC(t3);
+        if (Fixed(t3, t4))
+            continue;
         G2 = G1 + C(t3, t4);
         /* Try 3-opt move */
         for (Nt4 = t4->CandidateSet; (t5 = Nt4->To); Nt4++) {
@@ -32,13 +38,21 @@ void SpecialMove(Node * t1, Node * t2, long long * G0, long long * Gain)
                 (G3 = G2 - Nt4->Cost) <= 0 || !BETWEEN(t2, t5, t3))
                 continue;
             t6 = SUC(t5);
+            if (Fixed(t5, t6))
+                continue;
             *Gain = G3 + C(t5, t6) - C(t6, t1);
             if (*Gain > 0) {
                 Swap3(t1, t2, t4, t6, t5, t4, t6, t2, t3);
-                if (Improvement(Gain, t1, t2))
+                if (Improvement(Gain, t1, t2)) {
+                    Stats.ThreeOptMoves++;
+                    Stats.SpecialMoveCandidates += Examined +
+                        (Nt2 - t2->CandidateSet + 1) +
+                        (Nt4 - t4->CandidateSet + 1);
                     return;
+                }
             }
         }
+        Examined += Nt4 - t4->CandidateSet;
         if (t1 == SUC(t4)) 
             continue;
         /* Try special 4-opt */
@@ -54,6 +68,8 @@ void SpecialMove(Node * t1, Node * t2, long long * G0, long long * Gain)
                 if (t6 == t6Old)
                     break;
             }
+            if (Fixed(t5, t6))
+                continue;
             for (Case78 = 1; Case78 <= 2; Case78++) {
                 if (Case78 == 1) {
                     t8 = PRED(t1);
@@ -65,15 +81,22 @@ void SpecialMove(Node * t1, Node * t2, long long * G0, long long * Gain)
                     if (t7 == t7Old)
                         break;
                 }
+                if (Fixed(t7, t8))
+                    continue;
                 G4 = G3 + C(t5, t6) + C(t7, t8);
                 *Gain = G4 - C(t6, t7) - C(t8, t5);
                 if (*Gain > 0) {
                     Swap3(t1, t2, t4, t7, t8, t5, t1, t3, t2);
-                    if (Improvement(Gain, t1, t2))
+                    if (Improvement(Gain, t1, t2)) {
+                        Stats.FourOptMoves++;
+                        Stats.SpecialMoveCandidates += Examined +
+                            (Nt2 - t2->CandidateSet + 1);
                         return;
+                    }
                 }
             }
         }
     }
+    Stats.SpecialMoveCandidates += Examined + (Nt2 - t2->CandidateSet);
     *Gain = PenaltyGain = 0;
 }
@@ -0,0 +1,91 @@
+#include "LKH.h"
+
+/*
+ * The functions in this file implement the stopping rules given by the
+ * parameters STAGNATION_TRIALS, STAGNATION_TIME and MIN_IMPROVEMENT_RATE.
+ *
+ * The RecordProgress function is called each time a tour has been found
+ * (after each trial, and after each run). Penalty and Cost are the
+ * penalty and cost of the tour, and Trials is the number of trials the
+ * call accounts for. The progress is measured in terms of the objective
+ * PENALTY_MULTIPLIER * Penalty + Cost. The time of the last improvement
+ * is recorded in LastImprovementTime.
+ *
+ * The Stagnated function returns 1 if the search should be stopped
+ * because one of the stopping rules is satisfied; otherwise 0. Once the
+ * function has returned 1, it keeps returning 1.
+ */
+
+typedef struct ProgressRecord {
+    double Time;
+    long long Objective;
+} ProgressRecord;
+
+static ProgressRecord *History = 0;
+static int HistorySize = 0, HistoryMax = 0;
+static int TrialsSinceImprovement = 0;
+static int Stopped = 0;
+
+void RecordProgress(long long Penalty, long long Cost, int Trials)
+{
+    long long Objective;
+
+    if (Cost == LLONG_MAX || Penalty == LLONG_MAX)
+        return;
+    TrialsSinceImprovement += Trials;
+    Objective = PenaltyMultiplier * Penalty + Cost;
+    if (HistorySize > 0 &&
+        Objective >= History[HistorySize - 1].Objective)
+        return;
+    TrialsSinceImprovement = 0;
+    if (HistorySize == HistoryMax) {
+        HistoryMax = HistoryMax ? 2 * HistoryMax : 64;
+        History = (ProgressRecord *)
+            realloc(History, HistoryMax * sizeof(ProgressRecord));
+    }
+    History[HistorySize].Time = LastImprovementTime = GetTime();
+    History[HistorySize].Objective = Objective;
+    HistorySize++;
+}
+
+int Stagnated()
+{
+    double Now, Since;
+    long long Old, New;
+    int i;
+
+    if (Stopped)
+        return 1;
+    if (HistorySize == 0)
+        return 0;
+    if (StagnationTrials > 0 && TrialsSinceImprovement >= StagnationTrials) {
+        if (TraceLevel >= 1)
+            printff("*** No improvement in %d trials ***\n",
+                    StagnationTrials);
+        return Stopped = 1;
+    }
+    Now = GetTime();
+    if (Now - History[HistorySize - 1].Time >= StagnationTime) {
+        if (TraceLevel >= 1)
+            printff("*** No improvement in %0.1f sec. ***\n",
+                    StagnationTime);
+        return Stopped = 1;
+    }
+    if (MinImprovementRate > 0 &&
+        Now - History[0].Time >= ImprovementRateWindow) {
+        /* Find the best objective value at the start of the window */
+        Since = Now - ImprovementRateWindow;
+        for (i = HistorySize - 1; i > 0 && History[i].Time > Since; i--);
+        Old = History[i].Objective;
+        New = History[HistorySize - 1].Objective;
+        if ((double) (Old - New) <
+            MinImprovementRate * ImprovementRateWindow *
+            (Old < 0 ? -Old : Old)) {
+            if (TraceLevel >= 1)
+                printff("*** Improvement rate below %g ***\n",
+                        MinImprovementRate);
+            return Stopped = 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include "LKH.h"
+
+/*
+ * The TimeLimitExceeded function returns 1 if the time limit (TIME_LIMIT)
+ * has been reached; otherwise 0.
+ *
+ * If the best tour has been improved during the last quarter of the time
+ * limit, the search is considered to be still making progress, and the
+ * time limit is extended by a quarter of its original value. The total
+ * extension is at most TimeExtension seconds.
+ */
+
+int TimeLimitExceeded()
+{
+    static double Extended = 0;
+    double Time = GetTime() - StartTime, Quarter, Delta;
+
+    if (Time < TimeLimit)
+        return 0;
+    Quarter = (TimeLimit - Extended) / 4;
+    if (Extended < TimeExtension && Quarter > 0 &&
+        LastImprovementTime - StartTime >= TimeLimit - Quarter) {
+        Delta = Quarter;
+        if (Delta > TimeExtension - Extended)
+            Delta = TimeExtension - Extended;
+        TimeLimit += Delta;
+        Extended += Delta;
+        if (TraceLevel >= 1)
+            printff("*** Time limit extended to %0.1f sec. ***\n",
+                    TimeLimit);
+        return Time >= TimeLimit;
+    }
+    return 1;
+}
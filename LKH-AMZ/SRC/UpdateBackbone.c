@@ -0,0 +1,124 @@
+#include "LKH.h"
+
+/*
+ * The UpdateBackbone function implements the backbone edge fixing given
+ * by the parameter BACKBONE_RUNS. It is called after each run, when the
+ * tour of the run is held in Suc, and the best tour has been updated.
+ *
+ * As long as no edges are fixed, the tours of the runs are collected:
+ * the arcs common to all collected tours (the backbone) are kept in the
+ * BackboneSuc field of the nodes. When BackboneRuns tours have been
+ * collected, each backbone arc (N,M) is fixed as the edge between N and
+ * the twin of M. The subsequent runs then search the much smaller space
+ * of tours containing the backbone. When BackboneRuns consecutive runs
+ * have not improved the best tour, the fixes are released, and a new
+ * backbone is collected.
+ *
+ * The edges are fixed by means of FixedTo2, since FixedTo1 of each node
+ * holds its twin (as assumed by Flip), and are marked in BackboneFixedTo.
+ * Like any fixed edge, a fixed backbone edge has distance 0 (see
+ * D_FUNCTION); its real distance is accounted for by BackboneCost. Each
+ * fixed edge is made a candidate edge of both its end nodes, so that the
+ * tour construction of ChooseInitialTour includes it. The costs of the
+ * candidate edges are updated when the edges are fixed and released. No
+ * edge is fixed at a node whose FixedTo2 is already in use (by
+ * FIXED_EDGES_SECTION). The arc leaving the depot is never fixed, so the
+ * tour is never fixed as a whole.
+ */
+
+#define Twin(N) (&NodeSet[(N)->Id + DimensionSaved])
+
+static int Tours = 0, Fixes = 0, Fixing = 0, RunsSinceImprovement;
+static long long LastPenalty, LastCost;
+
+static Node *Successor(Node * N);
+static void SetCandidate(Node * From, Node * To);
+
+void UpdateBackbone()
+{
+    Node *N, *M;
+    int i;
+
+    if (Fixing) {
+        if (BestPenalty < LastPenalty ||
+            (BestPenalty == LastPenalty && BestCost < LastCost)) {
+            LastPenalty = BestPenalty;
+            LastCost = BestCost;
+            RunsSinceImprovement = 0;
+            return;
+        }
+        if (++RunsSinceImprovement < BackboneRuns)
+            return;
+        for (i = 1; i <= Dimension; i++) {
+            N = &NodeSet[i];
+            if ((M = N->BackboneFixedTo)) {
+                N->FixedTo2 = N->BackboneFixedTo = 0;
+                M->FixedTo2 = M->BackboneFixedTo = 0;
+                SetCandidate(N, M);
+                SetCandidate(M, N);
+            }
+        }
+        if (TraceLevel >= 1)
+            printff("Backbone: %d edges released\n", Fixes);
+        Fixing = Tours = 0;
+        return;
+    }
+    for (i = 1; i <= DimensionSaved; i++) {
+        N = &NodeSet[i];
+        M = Successor(N);
+        if (Tours == 0)
+            N->BackboneSuc = M;
+        else if (N->BackboneSuc != M)
+            N->BackboneSuc = 0;
+    }
+    if (++Tours < BackboneRuns)
+        return;
+    Tours = Fixes = 0;
+    for (i = 1; i <= DimensionSaved; i++) {
+        N = &NodeSet[i];
+        if (N == Depot || !N->BackboneSuc)
+            continue;
+        M = Twin(N->BackboneSuc);
+        if (N->FixedTo2 || M->FixedTo2)
+            continue;
+        N->FixedTo2 = N->BackboneFixedTo = M;
+        M->FixedTo2 = M->BackboneFixedTo = N;
+        SetCandidate(N, M);
+        SetCandidate(M, N);
+        Fixes++;
+    }
+    if (TraceLevel >= 1)
+        printff("Backbone: %d edges fixed\n", Fixes);
+    if ((Fixing = Fixes > 0)) {
+        LastPenalty = BestPenalty;
+        LastCost = BestCost;
+        RunsSinceImprovement = 0;
+    }
+}
+
+/*
+ * Successor returns the successor of node N (N <= DimensionSaved) in the
+ * asymmetric tour represented by Suc. In a tour oriented as the tour
+ * constructed by MergeTourWithBestTour, N is preceded by its twin and
+ * followed by the twin of its successor.
+ */
+
+static Node *Successor(Node * N)
+{
+    Node *T = N->Suc != Twin(N) ? N->Suc : N->Pred;
+    return &NodeSet[T->Id - DimensionSaved];
+}
+
+/*
+ * SetCandidate makes (From,To) a candidate edge of From (with Alpha-value
+ * 0, if it is new), and sets its cost to the current value of C(From,To).
+ */
+
+static void SetCandidate(Node * From, Node * To)
+{
+    Candidate *NFrom;
+
+    AddCandidate(From, To, C(From, To), 0);
+    for (NFrom = From->CandidateSet; NFrom->To != To; NFrom++);
+    NFrom->Cost = C(From, To);
+}
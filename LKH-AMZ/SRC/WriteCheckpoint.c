@@ -0,0 +1,88 @@
+#include "LKH.h"
+
+/*
+ * The WriteCheckpoint function is called each time a better tour has been
+ * found. It writes the tour to CHECKPOINT_FILE (or, if CHECKPOINT_FILE is
+ * not given, to TOUR_FILE), so that the best tour found so far survives if
+ * the process is killed.
+ *
+ * Tour is an array representation of the tour, Objective is its value of
+ * PENALTY_MULTIPLIER * penalty + cost, and Cost is its cost. A tour that
+ * is not better than the last tour written (or pending) is ignored.
+ * Otherwise, a copy of the tour becomes pending, and it is written as
+ * soon as at least CHECKPOINT_INTERVAL seconds have elapsed since the
+ * last write. The function is also called with Tour equal to 0 before
+ * each trial and after each run, in order to write a pending tour when
+ * the interval has passed.
+ *
+ * Each checkpoint overwrites the same file: any character $ in the file
+ * name is replaced by the string "checkpoint", not by the cost.
+ *
+ * The tour file is written atomically by WriteTour.
+ */
+
+static char *CheckpointName(char *Name);
+
+void WriteCheckpoint(int *Tour, long long Objective, long long Cost)
+{
+    static long long LastObjective = LLONG_MAX, PendingObjective,
+        PendingCost;
+    static double LastTime = -DBL_MAX;
+    static int *PendingTour = 0, Pending = 0;
+    static char *FileName = 0;
+    long long OldCurrentPenalty = CurrentPenalty,
+        OldBestPenalty = BestPenalty;
+    double Now;
+
+    if (CheckpointInterval == DBL_MAX ||
+        !(CheckpointFileName || TourFileName))
+        return;
+    if (Tour) {
+        if (Objective >= LastObjective ||
+            (Pending && Objective >= PendingObjective))
+            return;
+        if (!PendingTour)
+            PendingTour =
+                (int *) malloc((DimensionSaved + 1) * sizeof(int));
+        memcpy(PendingTour, Tour, (DimensionSaved + 1) * sizeof(int));
+        PendingObjective = Objective;
+        PendingCost = Cost;
+        Pending = 1;
+    }
+    if (!Pending || (Now = GetTime()) - LastTime < CheckpointInterval)
+        return;
+    if (!FileName)
+        FileName = CheckpointName(CheckpointFileName ? CheckpointFileName :
+                                  TourFileName);
+    Pending = 0;
+    LastObjective = PendingObjective;
+    LastTime = Now;
+    CurrentPenalty = BestPenalty = PendingObjective;
+    WriteTour(FileName, PendingTour, PendingCost);
+    CurrentPenalty = OldCurrentPenalty;
+    BestPenalty = OldBestPenalty;
+}
+
+/*
+ * The CheckpointName function returns a copy of the string Name where all
+ * occurrences of the character '$' have been replaced by "checkpoint".
+ */
+
+static char *CheckpointName(char *Name)
+{
+    char *NewName, *Pos;
+    int Count = 0;
+
+    for (Pos = Name; (Pos = strchr(Pos, '$')); Pos++)
+        Count++;
+    NewName = (char *) malloc(strlen(Name) + 9 * Count + 1);
+    for (Pos = NewName; *Name; Name++) {
+        if (*Name == '$') {
+            strcpy(Pos, "checkpoint");
+            Pos += 10;
+        } else
+            *Pos++ = *Name;
+    }
+    *Pos = '\0';
+    return NewName;
+}
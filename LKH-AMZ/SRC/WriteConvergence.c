@@ -0,0 +1,36 @@
+#include "LKH.h"
+
+/*
+ * The WriteConvergence function appends a line to CONVERGENCE_FILE each
+ * time a better tour (in the current run) or a new best tour (over all
+ * runs) has been found. The file is in CSV format with the columns
+ *
+ *     time,run,trial,penalty,cost,type
+ *
+ * where time is the CPU time in seconds since the start of the program
+ * (the time measured against TIME_LIMIT), penalty and cost are the
+ * penalty and cost of the tour, and type is B for a better tour and
+ * G for a new global best tour.
+ *
+ * The file is opened at the first call. Output is buffered, but flushed
+ * each time a new best tour is reported. Nothing happens if no
+ * CONVERGENCE_FILE has been specified.
+ */
+
+void WriteConvergence(char Type, long long Penalty, long long Cost)
+{
+    static FILE *ConvergenceFile = 0;
+
+    if (!ConvergenceFileName)
+        return;
+    if (!ConvergenceFile) {
+        if (!(ConvergenceFile = fopen(ConvergenceFileName, "w")))
+            eprintf("Cannot open CONVERGENCE_FILE: \"%s\"",
+                    ConvergenceFileName);
+        fprintf(ConvergenceFile, "time,run,trial,penalty,cost,type\n");
+    }
+    fprintf(ConvergenceFile, "%0.4f,%d,%d,%lld,%lld,%c\n",
+            GetTime() - StartTime, Run, Trial, Penalty, Cost, Type);
+    if (Type == 'G')
+        fflush(ConvergenceFile);
+}
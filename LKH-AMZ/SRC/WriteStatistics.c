@@ -0,0 +1,65 @@
+#include "LKH.h"
+#include <sys/resource.h>
+
+/*
+ * The WriteStatistics function writes the phase times and counters
+ * accumulated in Stats to file FileName in JSON format, together with
+ * the objective value (PENALTY_MULTIPLIER * penalty + cost) and cost of
+ * the best tour, and the peak resident set size.
+ *
+ * All times, except cpu_total, are wall clock times in seconds. The
+ * Ascent time does not include the time spent in GenerateCandidates.
+ *
+ * Nothing happens if FileName is 0.
+ */
+
+void WriteStatistics(char *FileName)
+{
+    FILE *StatsFile;
+    struct rusage ru;
+    char *p;
+
+    if (FileName == 0)
+        return;
+    if (!(StatsFile = fopen(FileName, "w")))
+        eprintf("Cannot open STATS_FILE: \"%s\"", FileName);
+    getrusage(RUSAGE_SELF, &ru);
+    fprintf(StatsFile, "{\n  \"name\": \"");
+    for (p = Name; p && *p; p++)
+        fprintf(StatsFile, *p == '"' || *p == '\\' ? "\\%c" : "%c", *p);
+    fprintf(StatsFile, "\",\n");
+    fprintf(StatsFile, "  \"dimension\": %d,\n", DimensionSaved);
+    fprintf(StatsFile, "  \"objective\": %lld,\n", BestPenalty);
+    fprintf(StatsFile, "  \"cost\": %lld,\n", BestCost);
+    fprintf(StatsFile, "  \"runs\": %d,\n", Run - 1);
+    fprintf(StatsFile, "  \"time\": {\n");
+    fprintf(StatsFile, "    \"read_problem\": %0.6f,\n",
+            Stats.ReadProblemTime);
+    fprintf(StatsFile, "    \"ctsp_transform\": %0.6f,\n",
+            Stats.CTSPTransformTime);
+    fprintf(StatsFile, "    \"ascent\": %0.6f,\n", Stats.AscentTime);
+    fprintf(StatsFile, "    \"generate_candidates\": %0.6f,\n",
+            Stats.GenerateCandidatesTime);
+    fprintf(StatsFile, "    \"trials\": %0.6f,\n", Stats.TrialTime);
+    fprintf(StatsFile, "    \"merging\": %0.6f,\n", Stats.MergeTime);
+    fprintf(StatsFile, "    \"total\": %0.6f,\n",
+            GetWallTime() - Stats.StartTime);
+    fprintf(StatsFile, "    \"cpu_total\": %0.6f\n", GetTime() - StartTime);
+    fprintf(StatsFile, "  },\n");
+    fprintf(StatsFile, "  \"counters\": {\n");
+    fprintf(StatsFile, "    \"trials\": %lld,\n", Stats.Trials);
+    fprintf(StatsFile, "    \"penalty_calls\": %lld,\n", Stats.PenaltyCalls);
+    fprintf(StatsFile, "    \"special_move_candidates\": %lld,\n",
+            Stats.SpecialMoveCandidates);
+    fprintf(StatsFile, "    \"improving_moves\": {\n");
+    fprintf(StatsFile, "      \"3-opt\": %lld,\n", Stats.ThreeOptMoves);
+    fprintf(StatsFile, "      \"4-opt\": %lld\n", Stats.FourOptMoves);
+    fprintf(StatsFile, "    },\n");
+    fprintf(StatsFile, "    \"hash_hits\": %lld,\n", Stats.HashHits);
+    fprintf(StatsFile, "    \"kicks\": %lld,\n", Stats.Kicks);
+    fprintf(StatsFile, "    \"merges\": %lld\n", Stats.Merges);
+    fprintf(StatsFile, "  },\n");
+    fprintf(StatsFile, "  \"peak_rss_kb\": %ld\n", ru.ru_maxrss);
+    fprintf(StatsFile, "}\n");
+    fclose(StatsFile);
+}
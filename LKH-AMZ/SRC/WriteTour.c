@@ -8,6 +8,14 @@
  * and continuing in direction of its lowest numbered
  * neighbor.
  *
+ * With sparse costs (SPARSE_NEIGHBORS > 0), the cost of the tour is an
+ * estimate (see Distance_SPARSE), and the second line of the file reads
+ * "COMMENT : Estimated cost = ..." instead of "COMMENT : Cost = ...".
+ *
+ * The file is written atomically: the tour is first written to a
+ * temporary file, which is then renamed to FileName. Thus, a process
+ * reading the file never sees a partially written tour.
+ *
  * Nothing happens if FileName is 0.
  */
 
@@ -15,10 +23,10 @@ void WriteTour(char *FileName, int *Tour, long long Cost)
 {
     FILE *TourFile;
     int i, j, n;
-    char *FullFileName;
+    char *FullFileName, *TmpFileName;
     time_t Now;
     long long tw_viol;
-    int num_tw_viol;
+    int num_tw_viol = 0;
 
     if (FileName == 0)
         return;
@@ -28,14 +36,18 @@ void WriteTour(char *FileName, int *Tour, long long Cost)
         printff("Writing%s: \"%s\" ... ",
                 FileName == TourFileName ? " TOUR_FILE" : "",
                 FullFileName);
-    TourFile = fopen(FullFileName, "w");
+    TmpFileName = (char *) malloc(strlen(FullFileName) + 5);
+    sprintf(TmpFileName, "%s.tmp", FullFileName);
+    if (!(TourFile = fopen(TmpFileName, "w")))
+        eprintf("Cannot open \"%s\"", TmpFileName);
     fprintf(TourFile, "NAME : %s.%lld_%lld.tour\n",
             Name, BestPenalty, Cost);
-    fprintf(TourFile,
-            "COMMENT : Cost = %lld_%lld\n", CurrentPenalty, Cost);
+    fprintf(TourFile, "COMMENT : %s = %lld_%lld\n",
+            Distance == Distance_SPARSE ? "Estimated cost" : "Cost",
+            CurrentPenalty, Cost);
     fprintf(TourFile, "COMMENT : Found by LKH-AMZ [Keld Helsgaun] %s",
             ctime(&Now));
-    tw_viol =  TotalTWViolation(&num_tw_viol);
+    tw_viol = TotalTWViolation(Tour, &num_tw_viol);
     fprintf(TourFile, "COMMENT : TW viol.: %lld #: %d\n", tw_viol, num_tw_viol);
     fprintf(TourFile, "TYPE : TOUR\n");
     fprintf(TourFile, "DIMENSION : %d\n", DimensionSaved);
@@ -50,6 +62,9 @@ void WriteTour(char *FileName, int *Tour, long long Cost)
     }
     fprintf(TourFile, "-1\nEOF\n");
     fclose(TourFile);
+    if (rename(TmpFileName, FullFileName))
+        eprintf("Cannot rename \"%s\"", TmpFileName);
+    free(TmpFileName);
     free(FullFileName);
     if (TraceLevel >= 1)
         printff("done\n");
@@ -0,0 +1,359 @@
+#include "LKH.h"
+
+/*
+ * The ZoneInitialTour function computes an initial tour in which the
+ * clusters (zones) are visited in an order that is consistent with the
+ * precedence and path constraints of the problem.
+ *
+ * The clusters are sequenced greedily, starting with the cluster of the
+ * depot. A cluster is eligible if each cluster that must precede it
+ * according to a ZONE_PRECEDENCE or ZONE_PATH constraint (or the super
+ * and super super counterparts of these constraints) has already been
+ * sequenced. Constraints that belong to an OR group are ignored. Among
+ * the eligible clusters, the next cluster is chosen as follows:
+ *
+ *  (1) If possible, it is chosen in the current super super cluster and,
+ *      if possible, in the current super cluster. Otherwise, if possible,
+ *      it is chosen in a path successor of the current super (super)
+ *      cluster.
+ *  (2) If possible, a path successor of the current cluster is chosen.
+ *      Otherwise, if possible, a neighbor of the current cluster is
+ *      chosen.
+ *  (3) Among the remaining alternatives, the cluster nearest to the last
+ *      sequenced node is chosen.
+ *
+ * If no cluster is eligible (the constraints are cyclic), the eligibility
+ * requirement is dropped.
+ *
+ * Inside a cluster the nodes are chained greedily. The first node is the
+ * node nearest to the last node of the previous cluster. Each following
+ * node is the nearest candidate of its predecessor among the unvisited
+ * nodes of the cluster, or, if no such candidate exists, the nearest
+ * unvisited node of the cluster.
+ *
+ * The function returns the cost of the tour. If the problem contains
+ * fixed edges (other than the edges of the ATSP transformation), the
+ * current tour is left unchanged, and LLONG_MAX is returned.
+ */
+
+#define Twin(N) (&NodeSet[(N)->Id + DimensionSaved])
+#define SuperId(Cl) ((Cl)->MySuperCluster->Id)
+#define SuperSuperId(Cl) ((Cl)->MySuperCluster->MySuperSuperCluster->Id)
+
+enum RestrictionTypes { SUPER_SUPER, SUPER_SUPER_PATH, SUPER, SUPER_PATH,
+    PATH, NEIGHBOR
+};
+
+static Cluster **ClusterSet;
+static char *Placed, *Eligible;
+static char *Blocked, *SuperBlocked, *SuperSuperBlocked;
+static char *SuperDone, *SuperSuperDone;
+static int *SuperLeft, *SuperSuperLeft;
+static Node *Last;
+
+static void Block(ZoneConstraint * Z, char *Done, char *Blocked,
+                  int DepotId);
+static void ComputeEligible(void);
+static int Constrained(ZoneConstraint * Z, int A, int B);
+static Node *NearestCandidateInCluster(Node * From, Cluster * Cl);
+static Node *NearestInCluster(Node * From, Cluster * Cl);
+static void Place(Cluster * Cl);
+static int Restrict(int Type, Cluster * Current);
+static long long TravelCost(Node * Na, Node * Nb);
+
+long long ZoneInitialTour()
+{
+    Node *N;
+    Cluster *Cl, *Current, *Best;
+    long long Cost, MinCost;
+    int Count, i;
+
+    for (i = 1; i <= DimensionSaved; i++) {
+        N = &NodeSet[i];
+        if ((N->FixedTo1 && N->FixedTo1 != Twin(N)) ||
+            (N->FixedTo2 && N->FixedTo2 != Twin(N)))
+            return LLONG_MAX;
+    }
+    ClusterSet = (Cluster **) malloc((GTSPSets + 1) * sizeof(Cluster *));
+    Placed = (char *) calloc(GTSPSets + 1, sizeof(char));
+    Eligible = (char *) calloc(GTSPSets + 1, sizeof(char));
+    Blocked = (char *) calloc(GTSPSets + 1, sizeof(char));
+    SuperBlocked = (char *) calloc(SuperGTSPSets + 1, sizeof(char));
+    SuperSuperBlocked = (char *) calloc(SuperSuperGTSPSets + 1, sizeof(char));
+    SuperDone = (char *) calloc(SuperGTSPSets + 1, sizeof(char));
+    SuperSuperDone = (char *) calloc(SuperSuperGTSPSets + 1, sizeof(char));
+    SuperLeft = (int *) calloc(SuperGTSPSets + 1, sizeof(int));
+    SuperSuperLeft = (int *) calloc(SuperSuperGTSPSets + 1, sizeof(int));
+    for (Cl = FirstCluster; Cl; Cl = Cl->Next) {
+        ClusterSet[Cl->Id] = Cl;
+        if (SuperGTSPSets) {
+            SuperLeft[SuperId(Cl)]++;
+            if (SuperSuperGTSPSets)
+                SuperSuperLeft[SuperSuperId(Cl)]++;
+        }
+    }
+
+    /* Mark all nodes as "not chosen" by setting their V field to zero */
+    for (i = 1; i <= DimensionSaved; i++)
+        NodeSet[i].V = 0;
+
+    /* Start the tour at the depot */
+    Depot->V = 1;
+    Last = Depot;
+    Place(Current = Depot->MyCluster);
+
+    for (Count = 1; Count < GTSPSets; Count++) {
+        ComputeEligible();
+        if (SuperGTSPSets) {
+            if (SuperSuperGTSPSets && !Restrict(SUPER_SUPER, Current))
+                Restrict(SUPER_SUPER_PATH, Current);
+            if (!Restrict(SUPER, Current))
+                Restrict(SUPER_PATH, Current);
+        }
+        if (!Restrict(PATH, Current))
+            Restrict(NEIGHBOR, Current);
+        Best = 0;
+        MinCost = LLONG_MAX;
+        for (i = 1; i <= GTSPSets; i++) {
+            if (!Eligible[i])
+                continue;
+            Cl = ClusterSet[i];
+            Cost = TravelCost(Last, NearestInCluster(Last, Cl));
+            if (Cost < MinCost) {
+                MinCost = Cost;
+                Best = Cl;
+            }
+        }
+        Place(Current = Best);
+    }
+    Follow(Twin(Depot), Last);
+
+    free(ClusterSet);
+    free(Placed);
+    free(Eligible);
+    free(Blocked);
+    free(SuperBlocked);
+    free(SuperSuperBlocked);
+    free(SuperDone);
+    free(SuperSuperDone);
+    free(SuperLeft);
+    free(SuperSuperLeft);
+
+    Cost = 0;
+    N = FirstNode;
+    do
+        Cost += C(N, N->Suc) - N->Pi - N->Suc->Pi;
+    while ((N = N->Suc) != FirstNode);
+    return Cost / Precision;
+}
+
+/*
+ * The Place function appends the unvisited nodes of cluster Cl to the
+ * partial tour that starts at the depot and ends at node Last. In the
+ * doubled (ATSP) representation, the nodes of the tour are ordered as
+ * follows: Depot, Twin(N1), N1, Twin(N2), N2, ..., Twin(Depot).
+ */
+
+static void Place(Cluster * Cl)
+{
+    Node *N;
+
+    Placed[Cl->Id] = 1;
+    if (SuperGTSPSets) {
+        SuperDone[SuperId(Cl)] = --SuperLeft[SuperId(Cl)] == 0;
+        if (SuperSuperGTSPSets)
+            SuperSuperDone[SuperSuperId(Cl)] =
+                --SuperSuperLeft[SuperSuperId(Cl)] == 0;
+    }
+    N = Last->MyCluster == Cl ? NearestCandidateInCluster(Last, Cl) :
+        NearestInCluster(Last, Cl);
+    while (N) {
+        Follow(Twin(N), Last);
+        Follow(N, Twin(N));
+        N->V = 1;
+        Last = N;
+        N = NearestCandidateInCluster(Last, Cl);
+    }
+}
+
+/*
+ * The ComputeEligible function marks the clusters that may be chosen as
+ * the next cluster in the sequence.
+ */
+
+static void ComputeEligible()
+{
+    Cluster *Cl;
+    int i, Count = 0;
+
+    memset(Blocked, 0, (GTSPSets + 1) * sizeof(char));
+    Block(FirstZonePrecedenceConstraint, Placed, Blocked,
+          Depot->MyCluster->Id);
+    Block(FirstZonePathConstraint, Placed, Blocked, Depot->MyCluster->Id);
+    if (SuperGTSPSets) {
+        memset(SuperBlocked, 0, (SuperGTSPSets + 1) * sizeof(char));
+        Block(FirstSuperZonePrecedenceConstraint, SuperDone, SuperBlocked,
+              SuperId(Depot->MyCluster));
+        Block(FirstSuperZonePathConstraint, SuperDone, SuperBlocked,
+              SuperId(Depot->MyCluster));
+        if (SuperSuperGTSPSets) {
+            memset(SuperSuperBlocked, 0,
+                   (SuperSuperGTSPSets + 1) * sizeof(char));
+            Block(FirstSuperSuperZonePrecedenceConstraint, SuperSuperDone,
+                  SuperSuperBlocked, SuperSuperId(Depot->MyCluster));
+            Block(FirstSuperSuperZonePathConstraint, SuperSuperDone,
+                  SuperSuperBlocked, SuperSuperId(Depot->MyCluster));
+        }
+    }
+    for (i = 1; i <= GTSPSets; i++) {
+        Cl = ClusterSet[i];
+        Eligible[i] = !Placed[i] && !Blocked[i] &&
+            (!SuperGTSPSets ||
+             (!SuperBlocked[SuperId(Cl)] &&
+              (!SuperSuperGTSPSets || !SuperSuperBlocked[SuperSuperId(Cl)])));
+        Count += Eligible[i];
+    }
+    if (Count == 0)
+        for (i = 1; i <= GTSPSets; i++)
+            Eligible[i] = !Placed[i];
+}
+
+/*
+ * The Block function marks B as blocked for each constraint (A,B) in the
+ * list Z for which A is not done. OR constraints, and constraints with
+ * the depot's set as B (which cannot be satisfied), are ignored.
+ */
+
+static void Block(ZoneConstraint * Z, char *Done, char *Blocked,
+                  int DepotId)
+{
+    ZoneConstraint *Prev = 0;
+
+    for (; Z; Prev = Z, Z = Z->Next)
+        if (Z->Type == AND && (!Prev || Prev->Type == AND) &&
+            !Done[Z->A] && Z->B != DepotId)
+            Blocked[Z->B] = 1;
+}
+
+/*
+ * The Constrained function returns 1 if the list Z contains the AND
+ * constraint (A,B); otherwise 0.
+ */
+
+static int Constrained(ZoneConstraint * Z, int A, int B)
+{
+    ZoneConstraint *Prev = 0;
+
+    for (; Z; Prev = Z, Z = Z->Next)
+        if (Z->A == A && Z->B == B &&
+            Z->Type == AND && (!Prev || Prev->Type == AND))
+            return 1;
+    return 0;
+}
+
+/*
+ * The Restrict function removes each eligible cluster that does not
+ * satisfy the restriction given by Type, provided that at least one of
+ * the eligible clusters satisfies it. The function returns the number
+ * of eligible clusters satisfying the restriction.
+ */
+
+static int Restrict(int Type, Cluster * Current)
+{
+    Cluster *Cl;
+    int i, Count = 0;
+    char OK;
+
+    for (i = 1; i <= GTSPSets; i++) {
+        if (!Eligible[i])
+            continue;
+        Cl = ClusterSet[i];
+        switch (Type) {
+        case SUPER_SUPER:
+            OK = SuperSuperId(Cl) == SuperSuperId(Current);
+            break;
+        case SUPER_SUPER_PATH:
+            OK = Constrained(FirstSuperSuperZonePathConstraint,
+                             SuperSuperId(Current), SuperSuperId(Cl));
+            break;
+        case SUPER:
+            OK = SuperId(Cl) == SuperId(Current);
+            break;
+        case SUPER_PATH:
+            OK = Constrained(FirstSuperZonePathConstraint,
+                             SuperId(Current), SuperId(Cl));
+            break;
+        case PATH:
+            OK = Constrained(FirstZonePathConstraint, Current->Id, Cl->Id);
+            break;
+        default:
+            OK = Constrained(FirstZoneNeighborConstraint,
+                             Current->Id, Cl->Id) ||
+                Constrained(FirstZoneNeighborConstraint,
+                            Cl->Id, Current->Id);
+        }
+        Eligible[i] = OK ? 1 : 2;
+        Count += OK;
+    }
+    for (i = 1; i <= GTSPSets; i++)
+        if (Eligible[i] == 2)
+            Eligible[i] = Count == 0;
+    return Count;
+}
+
+/*
+ * The NearestCandidateInCluster function returns the nearest unvisited
+ * node of cluster Cl among the candidates of node From. If no such node
+ * exists, the nearest unvisited node of Cl is returned (or 0, if all
+ * nodes of Cl have been visited).
+ */
+
+static Node *NearestCandidateInCluster(Node * From, Cluster * Cl)
+{
+    Node *N, *Nearest = 0, *To;
+    Candidate *NN;
+    long long Cost, MinCost = LLONG_MAX;
+
+    for (NN = From->CandidateSet; NN && (To = NN->To); NN++) {
+        if (To->Id <= DimensionSaved)
+            continue;
+        N = &NodeSet[To->Id - DimensionSaved];
+        if (!N->V && N->MyCluster == Cl &&
+            (Cost = TravelCost(From, N)) < MinCost) {
+            MinCost = Cost;
+            Nearest = N;
+        }
+    }
+    return Nearest ? Nearest : NearestInCluster(From, Cl);
+}
+
+/*
+ * The NearestInCluster function returns the unvisited node of cluster Cl
+ * nearest to node From, or 0 if all nodes of Cl have been visited.
+ */
+
+static Node *NearestInCluster(Node * From, Cluster * Cl)
+{
+    Node *N = Cl->First, *Nearest = 0;
+    long long Cost, MinCost = LLONG_MAX;
+
+    do {
+        if (!N->V && (Cost = TravelCost(From, N)) < MinCost) {
+            MinCost = Cost;
+            Nearest = N;
+        }
+    } while ((N = N->NextInCluster) != Cl->First);
+    return Nearest;
+}
+
+/*
+ * The TravelCost function returns the cost of going from node Na to
+ * node Nb, where Na and Nb are original (not twin) nodes.
+ */
+
+static long long TravelCost(Node * Na, Node * Nb)
+{
+    Node *Tb = Twin(Nb);
+
+    return (long long) C(Na, Tb) - Na->Pi - Tb->Pi;
+}
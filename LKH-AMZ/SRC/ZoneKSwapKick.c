@@ -0,0 +1,76 @@
+#include "LKH.h"
+
+/*
+ * The ZoneKSwapKick function makes a K-swap kick, K>=4, in which the tour
+ * is only cut at zone boundaries, that is, between two consecutive nodes
+ * belonging to different clusters. The K segments between the cuts are
+ * blocks of whole zones, and they are reconnected in the same way as in
+ * KSwapKick (for K = 4 this is a double-bridge move on zone blocks).
+ * Thus, the order of the nodes within each zone is left intact, and the
+ * subsequent Lin-Kernighan search does not have to repair broken zones.
+ *
+ * If the problem has super clusters, then every second kick cuts the tour
+ * at super cluster boundaries only (provided there are at least K such
+ * boundaries), so that whole super zones are moved.
+ *
+ * If the tour has less than K zone boundaries, an ordinary KSwapKick is
+ * made.
+ *
+ * The boundaries are found by a scan of the tour, which costs no more
+ * than the restoration of the tour preceding each kick (see
+ * ChooseInitialTour). The array of boundaries is allocated once.
+ */
+
+static int compare(const void *Na, const void *Nb);
+
+void ZoneKSwapKick(int K)
+{
+    static Node **Boundary = 0;
+    static int Super = 0;
+    Node **s, *N;
+    int Count = 0, SuperCount = 0, i, j;
+
+    if (!Boundary)
+        Boundary = (Node **) malloc(Dimension * sizeof(Node *));
+    N = FirstNode;
+    do {
+        if (N->MyCluster == N->Suc->MyCluster || Fixed(N, N->Suc))
+            continue;
+        Boundary[Count++] = N;
+        if (SuperGTSPSets > 0 &&
+            N->MyCluster->MySuperCluster !=
+            N->Suc->MyCluster->MySuperCluster) {
+            /* Keep the super cluster boundaries first */
+            Boundary[Count - 1] = Boundary[SuperCount];
+            Boundary[SuperCount++] = N;
+        }
+    }
+    while ((N = N->Suc) != FirstNode);
+    if (Count < K) {
+        KSwapKick(K);
+        return;
+    }
+    if (SuperCount >= K && (Super ^= 1))
+        Count = SuperCount;
+    Stats.Kicks++;
+
+    /* Choose K distinct boundaries at random */
+    s = Boundary;
+    for (i = 0; i < K; i++) {
+        j = i + Random() % (Count - i);
+        N = s[i];
+        s[i] = s[j];
+        s[j] = N;
+    }
+    FirstNode = s[0];
+    qsort(s, K, sizeof(Node *), compare);
+    for (i = 0; i < K; i++)
+        s[i]->OldSuc = s[i]->Suc;
+    for (i = 0; i < K; i++)
+        Link(s[(i + 2) % K], s[i]->OldSuc);
+}
+
+static int compare(const void *Na, const void *Nb)
+{
+    return (*(Node **) Na)->KickRank - (*(Node **) Nb)->KickRank;
+}
@@ -12,7 +12,8 @@ int main(int argc, char *argv[])
     fgets(line, 255, in);
     fgets(line, 255, in);
     fclose(in);
-    if (sscanf(line, "COMMENT : Length = %d", &length) != 1)
-        sscanf(line, "COMMENT : Cost = %d_%d", &penalty, &length);
+    if (sscanf(line, "COMMENT : Length = %d", &length) != 1 &&
+        sscanf(line, "COMMENT : Cost = %d_%d", &penalty, &length) != 2)
+        sscanf(line, "COMMENT : Estimated cost = %d_%d", &penalty, &length);
     printf("%d\n", length);
 }
@@ -0,0 +1,392 @@
+#include <dirent.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*
+ * Usage: ./merge_tours [ -t tolerance ] [ -p ] [ -m multiplier ]
+ *                      [ -r seconds ] [ -j jobs ]
+ *                      directory1 directory2 result_directory
+ *
+ * The merge_tours program chooses, for each instance (*.ctsptw) in
+ * directory1, either the tour in TOURS-directory1 or the tour in
+ * TOURS-directory2, and creates the symbolic links
+ *
+ *     result_directory/name.ctsptw -> ../directoryX/name.ctsptw
+ *     TOURS-result_directory/name.tour -> ../TOURS-directoryX/name.tour
+ *
+ * where X is 1 or 2. This is the selection made by the script merge:
+ * the first tour is chosen if
+ *
+ *     length1 <= floor(length2 * (1 + tolerance))
+ *
+ * where tolerance is 0.01 by default. The lengths are read from the
+ * second line of the tour files ("COMMENT : Length = length" or
+ * "COMMENT : Cost = objective_length"). A tour found with sparse costs
+ * (SPARSE_NEIGHBORS) has the line "COMMENT : Estimated cost =
+ * objective_length" instead. Its length is then computed from the cost
+ * matrix of its instance, since the estimated length may be far from the
+ * real one; its penalty is still based on estimated travel times. If -p
+ * is given, the penalties, (objective - length) / multiplier, where
+ * multiplier is the PENALTY_MULTIPLIER of the LKH runs (default 1500,
+ * as in LKH), are compared first, and the tour with the lower penalty is
+ * chosen; the lengths only decide between tours with equal penalties.
+ * If only one of the tours exists, it is chosen.
+ *
+ * If -r is given, the two tours of each instance are furthermore
+ * recombined by LKH on the instance in directory1: the tours are merged
+ * by iterative partial transcription, and the result is improved by LKH
+ * for the given number of seconds (see MERGE_TOUR_FILE in
+ * SRC/ReadParameters.c). If the resulting tour dominates both tours
+ * with respect to the penalty and length on that instance, it replaces
+ * the chosen tour: TOURS-result_directory/name.tour becomes a regular
+ * file, and result_directory/name.ctsptw links to directory1. At most
+ * jobs (default 16) LKH processes are run at the same time.
+ */
+
+typedef struct Pair {
+    char *Name;
+    pid_t Pid;
+} Pair;
+
+static int ReadTourHeader(char *Problem, char *FileName,
+                          long long Multiplier, long long *Penalty,
+                          long long *Length);
+static int TourLength(char *Problem, char *FileName, long long *Length);
+static void Link(char *Target, char *LinkName);
+static int MakeDirectory(char *Name);
+static pid_t Recombine(char *Dir1, char *Dir2, char *Result, char *Name,
+                       double Seconds);
+static int Recombined(char *Dir1, char *Result, char *Name);
+
+int main(int argc, char *argv[])
+{
+    char *Dir1, *Dir2, *Result, *Dot, *Name, *Chosen;
+    char Tour1[1024], Tour2[1024], Target[1024], LinkName[1024];
+    char Problem1[1024], Problem2[1024];
+    double Tolerance = 0.01;
+    int UsePenalty = 0, Ok1, Ok2, c, Count = 0, First = 0;
+    int Jobs = 16, Running = 0, Pairs = 0, MaxPairs = 64, Better = 0, i, j;
+    long long Penalty1, Length1, Penalty2, Length2, Multiplier = 1500;
+    double Seconds = 0;
+    Pair *Set;
+    pid_t Pid;
+    int Status;
+    DIR *Dir;
+    struct dirent *Entry;
+
+    while ((c = getopt(argc, argv, "t:pm:r:j:")) != -1) {
+        switch (c) {
+        case 't':
+            Tolerance = atof(optarg);
+            break;
+        case 'p':
+            UsePenalty = 1;
+            break;
+        case 'm':
+            Multiplier = atoll(optarg);
+            break;
+        case 'r':
+            Seconds = atof(optarg);
+            break;
+        case 'j':
+            Jobs = atoi(optarg);
+            break;
+        default:
+            optind = argc;
+        }
+    }
+    if (argc - optind != 3 || Jobs < 1 || Multiplier < 1) {
+        fprintf(stderr, "./merge_tours [ -t tolerance ] [ -p ] "
+                "[ -m multiplier ] [ -r seconds ] [ -j jobs ] "
+                "directory1 directory2 result_directory\n");
+        return EXIT_FAILURE;
+    }
+    Dir1 = argv[optind];
+    Dir2 = argv[optind + 1];
+    Result = argv[optind + 2];
+    if (!(Dir = opendir(Dir1))) {
+        fprintf(stderr, "Cannot open directory \"%s\"\n", Dir1);
+        return EXIT_FAILURE;
+    }
+    snprintf(LinkName, sizeof(LinkName), "TOURS-%s", Result);
+    if (!MakeDirectory(Result) || !MakeDirectory(LinkName)) {
+        closedir(Dir);
+        return EXIT_FAILURE;
+    }
+    Set = (Pair *) malloc(MaxPairs * sizeof(Pair));
+
+    while ((Entry = readdir(Dir))) {
+        Dot = strrchr(Entry->d_name, '.');
+        if (!Dot || strcmp(Dot, ".ctsptw"))
+            continue;
+        Name = Entry->d_name;
+        *Dot = '\0';
+        snprintf(Tour1, sizeof(Tour1), "TOURS-%s/%s.tour", Dir1, Name);
+        snprintf(Tour2, sizeof(Tour2), "TOURS-%s/%s.tour", Dir2, Name);
+        snprintf(Problem1, sizeof(Problem1), "%s/%s.ctsptw", Dir1, Name);
+        snprintf(Problem2, sizeof(Problem2), "%s/%s.ctsptw", Dir2, Name);
+        Ok1 = ReadTourHeader(Problem1, Tour1, Multiplier,
+                             &Penalty1, &Length1);
+        Ok2 = ReadTourHeader(Problem2, Tour2, Multiplier,
+                             &Penalty2, &Length2);
+        if (!Ok1 && !Ok2) {
+            fprintf(stderr, "%s: no tour\n", Name);
+            continue;
+        }
+        if (!Ok2)
+            Chosen = Dir1;
+        else if (!Ok1)
+            Chosen = Dir2;
+        else if (UsePenalty && Penalty1 != Penalty2)
+            Chosen = Penalty1 < Penalty2 ? Dir1 : Dir2;
+        else
+            Chosen = Length1 <= (long long)
+                floor(Length2 * (1 + Tolerance) + 1e-9) ? Dir1 : Dir2;
+        if (Chosen == Dir1)
+            First++;
+        snprintf(Target, sizeof(Target), "../%s/%s.ctsptw", Chosen, Name);
+        snprintf(LinkName, sizeof(LinkName), "%s/%s.ctsptw", Result, Name);
+        Link(Target, LinkName);
+        snprintf(Target, sizeof(Target), "../TOURS-%s/%s.tour",
+                 Chosen, Name);
+        snprintf(LinkName, sizeof(LinkName), "TOURS-%s/%s.tour",
+                 Result, Name);
+        Link(Target, LinkName);
+        Count++;
+        if (Ok1 && Ok2 && Seconds > 0) {
+            if (Pairs == MaxPairs)
+                Set = (Pair *) realloc(Set, (MaxPairs *= 2) * sizeof(Pair));
+            Set[Pairs].Name = strdup(Name);
+            Set[Pairs++].Pid = 0;
+        }
+    }
+    closedir(Dir);
+    printf("Merged %d tours: %d from %s, %d from %s\n",
+           Count, First, Dir1, Count - First, Dir2);
+
+    /* Recombine the pairs of tours, running at most Jobs processes */
+    for (i = 0; i < Pairs || Running > 0;) {
+        if (i < Pairs && Running < Jobs) {
+            if ((Set[i].Pid =
+                 Recombine(Dir1, Dir2, Result, Set[i].Name, Seconds)) > 0)
+                Running++;
+            i++;
+            continue;
+        }
+        if ((Pid = wait(&Status)) <= 0)
+            break;
+        Running--;
+        for (j = 0; j < i && Set[j].Pid != Pid; j++);
+        if (j < i && WIFEXITED(Status) && WEXITSTATUS(Status) == 0)
+            Better += Recombined(Dir1, Result, Set[j].Name);
+    }
+    if (Pairs > 0)
+        printf("Recombined %d tour pairs: %d improved\n", Pairs, Better);
+    for (i = 0; i < Pairs; i++)
+        free(Set[i].Name);
+    free(Set);
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Recombine starts an LKH process that recombines the tours of instance
+ * Name in TOURS-Dir1 and TOURS-Dir2. If the resulting tour dominates both
+ * tours, it is written to TOURS-Result/Name.rec.tour. The function returns
+ * the process id, or -1 if the process could not be started.
+ */
+
+static pid_t Recombine(char *Dir1, char *Dir2, char *Result, char *Name,
+                       double Seconds)
+{
+    char ParFileName[1024];
+    FILE *ParFile;
+    pid_t Pid;
+    int Null;
+
+    snprintf(ParFileName, sizeof(ParFileName), "TOURS-%s/%s.rec.par",
+             Result, Name);
+    if (!(ParFile = fopen(ParFileName, "w"))) {
+        perror(ParFileName);
+        return -1;
+    }
+    fprintf(ParFile, "PROBLEM_FILE = %s/%s.ctsptw\n", Dir1, Name);
+    fprintf(ParFile, "CTSP_TRANSFORM = YES\n");
+    fprintf(ParFile, "SEED = 1\n");
+    fprintf(ParFile, "TIME_LIMIT = %g\n", Seconds);
+    fprintf(ParFile, "TRACE_LEVEL = 0\n");
+    fprintf(ParFile, "INITIAL_TOUR_FILE = TOURS-%s/%s.tour\n", Dir1, Name);
+    fprintf(ParFile, "MERGE_TOUR_FILE = TOURS-%s/%s.tour\n", Dir2, Name);
+    fprintf(ParFile, "TOUR_FILE = TOURS-%s/%s.rec.tour\n", Result, Name);
+    fclose(ParFile);
+    if ((Pid = fork()) == 0) {
+        if ((Null = open("/dev/null", O_WRONLY)) >= 0)
+            dup2(Null, STDOUT_FILENO);
+        execl("./LKH", "./LKH", ParFileName, (char *) 0);
+        perror("./LKH");
+        _exit(EXIT_FAILURE);
+    }
+    if (Pid < 0)
+        perror("fork");
+    return Pid;
+}
+
+/*
+ * Recombined is called when the recombination of instance Name has
+ * finished. If a dominating tour was found, it replaces the link
+ * TOURS-Result/Name.tour, and Result/Name.ctsptw is linked to the
+ * instance in Dir1. The function returns 1 in that case; otherwise 0.
+ */
+
+static int Recombined(char *Dir1, char *Result, char *Name)
+{
+    char FileName[1024], Target[1024], LinkName[1024];
+    int Better = 0;
+
+    snprintf(FileName, sizeof(FileName), "TOURS-%s/%s.rec.tour",
+             Result, Name);
+    snprintf(LinkName, sizeof(LinkName), "TOURS-%s/%s.tour", Result, Name);
+    if (access(FileName, F_OK) == 0) {
+        if (rename(FileName, LinkName))
+            perror(LinkName);
+        else {
+            snprintf(Target, sizeof(Target), "../%s/%s.ctsptw",
+                     Dir1, Name);
+            snprintf(LinkName, sizeof(LinkName), "%s/%s.ctsptw",
+                     Result, Name);
+            Link(Target, LinkName);
+            Better = 1;
+        }
+    }
+    snprintf(FileName, sizeof(FileName), "TOURS-%s/%s.rec.par",
+             Result, Name);
+    unlink(FileName);
+    return Better;
+}
+
+/*
+ * ReadTourHeader reads the penalty and length of a tour from the second
+ * line of its file. The penalty is (objective - length) / Multiplier. If
+ * the cost is estimated, the length is computed from the instance in file
+ * Problem (see TourLength). The function returns 1 if successful;
+ * otherwise 0.
+ */
+
+static int ReadTourHeader(char *Problem, char *FileName,
+                          long long Multiplier, long long *Penalty,
+                          long long *Length)
+{
+    FILE *In = fopen(FileName, "r");
+    char Line[256];
+    long long Objective;
+    int Ok = 0;
+
+    if (!In)
+        return 0;
+    if (fgets(Line, sizeof(Line), In) && fgets(Line, sizeof(Line), In)) {
+        if (sscanf(Line, "COMMENT : Length = %lld", Length) == 1) {
+            *Penalty = 0;
+            Ok = 1;
+        } else if (sscanf(Line, "COMMENT : Cost = %lld_%lld",
+                          &Objective, Length) == 2) {
+            *Penalty = (Objective - *Length) / Multiplier;
+            Ok = 1;
+        } else if (sscanf(Line, "COMMENT : Estimated cost = %lld_%lld",
+                          &Objective, Length) == 2) {
+            *Penalty = (Objective - *Length) / Multiplier;
+            Ok = 2;
+        }
+    }
+    fclose(In);
+    return Ok == 2 ? TourLength(Problem, FileName, Length) : Ok;
+}
+
+/*
+ * TourLength computes the length of the tour in file FileName from the
+ * FULL_MATRIX of the instance in file Problem. The matrix is read row by
+ * row, so only linear memory is used. The function returns 1 if
+ * successful; otherwise 0.
+ */
+
+static int TourLength(char *Problem, char *FileName, long long *Length)
+{
+    FILE *In;
+    char Line[256];
+    int Dimension = 0, First = 0, Last = 0, Id, W, i, j, Ok = 1;
+    int *Suc;
+
+    if (!(In = fopen(FileName, "r")))
+        return 0;
+    while (fgets(Line, sizeof(Line), In) &&
+           strncmp(Line, "TOUR_SECTION", 12))
+        sscanf(Line, "DIMENSION : %d", &Dimension);
+    Suc = (int *) calloc(Dimension + 1, sizeof(int));
+    while (fscanf(In, "%d", &Id) == 1 && Id >= 1 && Id <= Dimension) {
+        if (Last)
+            Suc[Last] = Id;
+        else
+            First = Id;
+        Last = Id;
+    }
+    fclose(In);
+    if (Last)
+        Suc[Last] = First;
+    for (i = 1; i <= Dimension; i++)
+        if (!Suc[i])
+            Ok = 0;
+    if (!Ok || Dimension == 0 || !(In = fopen(Problem, "r"))) {
+        free(Suc);
+        return 0;
+    }
+    while (fgets(Line, sizeof(Line), In) &&
+           strncmp(Line, "EDGE_WEIGHT_SECTION", 19));
+    *Length = 0;
+    for (i = 1; Ok && i <= Dimension; i++) {
+        for (j = 1; j <= Dimension; j++) {
+            if (fscanf(In, "%d", &W) != 1) {
+                Ok = 0;
+                break;
+            }
+            if (j == Suc[i])
+                *Length += W;
+        }
+    }
+    fclose(In);
+    free(Suc);
+    return Ok;
+}
+
+/*
+ * Link creates the symbolic link LinkName to Target, replacing any
+ * existing file LinkName (as ln -fs).
+ */
+
+static void Link(char *Target, char *LinkName)
+{
+    if (unlink(LinkName) && errno != ENOENT)
+        perror(LinkName);
+    if (symlink(Target, LinkName))
+        perror(LinkName);
+}
+
+/*
+ * MakeDirectory creates the directory Name, unless it already exists.
+ * The function returns 1 on success; otherwise it reports the error and
+ * returns 0.
+ */
+
+static int MakeDirectory(char *Name)
+{
+    if (mkdir(Name, 0755) && errno != EEXIST) {
+        perror(Name);
+        return 0;
+    }
+    return 1;
+}
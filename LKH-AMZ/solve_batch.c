@@ -0,0 +1,278 @@
+#include <dirent.h>
+#include <errno.h>
+#include <libgen.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*
+ * Usage: ./solve_batch [ -t threads ] [ -m margin ] [ -s stagnation ]
+ *                      instances seconds
+ *
+ * The solve_batch program finds LKH tours for all instances (*.ctsptw)
+ * in the directory instances, such that the whole batch is finished
+ * within the given number of (wall clock) seconds. The tours are written
+ * to the directory TOURS-<name>, where <name> is the last component of
+ * the path instances. The parameter files of the LKH processes are
+ * written to the directory TMP and removed when the processes end.
+ *
+ * At most threads (default 16) LKH processes are run at the same time.
+ * The instances are started in order of decreasing dimension. When an
+ * instance is started, it is given a time limit computed from the core
+ * time that remains before the deadline (less margin seconds, default 1),
+ * minus the time still committed to the running instances (their time
+ * limits and time extensions). The remaining core time is shared among
+ * the instances not yet started in proportion to their dimensions. Hence,
+ * time given up by instances that finish early is handed out to the
+ * instances started later.
+ *
+ * Each LKH process stops when its best tour has not been improved for a
+ * fraction stagnation (default 0.25) of its time limit (STAGNATION_TIME),
+ * and it may extend its time limit by up to a half if its best tour is
+ * still improving near the limit (TIME_EXTENSION). An instance's share of
+ * the core time covers both its time limit and its time extension.
+ *
+ * Note that the deadline and the shares are measured in wall clock time,
+ * whereas LKH measures TIME_LIMIT in CPU time (user time summed over its
+ * threads, see GetTime). A process that waits for a core (more processes
+ * than cores) may therefore run beyond its share in wall clock time, and
+ * a process that uses several threads (CANDIDATE_SET_TYPE = NEAREST-
+ * NEIGHBOR) may stop before it. The scheduler only counts the wall clock
+ * share of a running process as committed; the deadline is enforced by
+ * killing the processes still running.
+ * Processes that are still running at the deadline are killed. Each
+ * process writes its best tour to its tour file after an improvement, at
+ * most once per CPU second (CHECKPOINT_INTERVAL), and its first tour is
+ * written at once. So an instance is left without a tour only if it is
+ * killed before its first trial has finished.
+ */
+
+typedef struct Instance {
+    char *Name, *FileName, *ParFileName;
+    int Dimension;
+    pid_t Pid;
+    double StartTime, TimeLimit, Extension;
+} Instance;
+
+static double WallTime(void);
+static int ReadDimension(char *FileName);
+static int ByDimension(const void *a, const void *b);
+
+int main(int argc, char *argv[])
+{
+    char *Directory, *TourDirectory, FileName[1024], ParFileName[1024];
+    int Threads = 16, Running = 0, Started = 0, Finished = 0, Killed = 0;
+    int Count = 0, Max = 64, i, c, Status;
+    long long WeightLeft = 0;
+    double Seconds, Margin = 1, Stagnation = 0.25, Deadline, Now,
+        Remaining, Committed, Capacity, TimeLimit, Extension;
+    Instance *Set, *I;
+    DIR *Dir;
+    struct dirent *Entry;
+    FILE *ParFile;
+    pid_t Pid;
+
+    while ((c = getopt(argc, argv, "t:m:s:")) != -1) {
+        switch (c) {
+        case 't':
+            Threads = atoi(optarg);
+            break;
+        case 'm':
+            Margin = atof(optarg);
+            break;
+        case 's':
+            Stagnation = atof(optarg);
+            break;
+        default:
+            optind = argc;
+        }
+    }
+    if (argc - optind != 2 || Threads < 1 ||
+        (Seconds = atof(argv[optind + 1])) <= 0) {
+        fprintf(stderr, "./solve_batch [ -t threads ] [ -m margin ] "
+                "[ -s stagnation ] instances seconds\n");
+        return EXIT_FAILURE;
+    }
+    Deadline = WallTime() + Seconds;
+    Directory = argv[optind];
+
+    if (!(Dir = opendir(Directory))) {
+        fprintf(stderr, "Cannot open directory \"%s\"\n", Directory);
+        return EXIT_FAILURE;
+    }
+    Set = (Instance *) malloc(Max * sizeof(Instance));
+    while ((Entry = readdir(Dir))) {
+        char *Dot = strrchr(Entry->d_name, '.');
+        if (!Dot || strcmp(Dot, ".ctsptw"))
+            continue;
+        if (Count == Max)
+            Set = (Instance *) realloc(Set, (Max *= 2) * sizeof(Instance));
+        I = &Set[Count++];
+        I->Name = strdup(Entry->d_name);
+        I->Name[Dot - Entry->d_name] = '\0';
+        snprintf(FileName, sizeof(FileName), "%s/%s",
+                 Directory, Entry->d_name);
+        I->FileName = strdup(FileName);
+        I->Dimension = ReadDimension(I->FileName);
+        I->ParFileName = 0;
+        I->Pid = 0;
+        WeightLeft += I->Dimension;
+    }
+    closedir(Dir);
+    qsort(Set, Count, sizeof(Instance), ByDimension);
+
+    strncpy(FileName, Directory, sizeof(FileName) - 1);
+    FileName[sizeof(FileName) - 1] = '\0';
+    snprintf(ParFileName, sizeof(ParFileName), "TOURS-%s",
+             basename(FileName));
+    TourDirectory = strdup(ParFileName);
+    if (mkdir(TourDirectory, 0755) && errno != EEXIST) {
+        fprintf(stderr, "Cannot create directory \"%s\"\n", TourDirectory);
+        return EXIT_FAILURE;
+    }
+    if (mkdir("TMP", 0755) && errno != EEXIST) {
+        fprintf(stderr, "Cannot create directory \"TMP\"\n");
+        return EXIT_FAILURE;
+    }
+
+    while (Finished < Count) {
+        Now = WallTime();
+        while (Running < Threads && Started < Count) {
+            I = &Set[Started];
+            Remaining = Deadline - Margin - Now;
+            Committed = 0;
+            for (i = 0; i < Started; i++) {
+                if (Set[i].Pid > 0 &&
+                    (TimeLimit = Set[i].TimeLimit + Set[i].Extension -
+                     (Now - Set[i].StartTime)) > 0)
+                    Committed += TimeLimit;
+            }
+            Capacity = Remaining * Threads - Committed;
+            /* The share covers the time limit and its extension (a half) */
+            TimeLimit = (WeightLeft > 0 ?
+                         Capacity * I->Dimension / WeightLeft :
+                         Capacity) / 1.5;
+            if (TimeLimit > Remaining)
+                TimeLimit = Remaining;
+            if (TimeLimit < 0.1)
+                TimeLimit = 0.1;
+            Extension = TimeLimit / 2;
+            if (Extension > Remaining - TimeLimit)
+                Extension = Remaining - TimeLimit;
+            snprintf(ParFileName, sizeof(ParFileName),
+                     "TMP/%s.pid%d.par", I->Name, (int) getpid());
+            if (!(ParFile = fopen(ParFileName, "w"))) {
+                fprintf(stderr, "Cannot write \"%s\"\n", ParFileName);
+                return EXIT_FAILURE;
+            }
+            fprintf(ParFile, "PROBLEM_FILE = %s\n", I->FileName);
+            fprintf(ParFile, "CTSP_TRANSFORM = YES\n");
+            fprintf(ParFile, "SEED = 1\n");
+            fprintf(ParFile, "TIME_LIMIT = %0.2f\n", TimeLimit);
+            if (Extension > 0)
+                fprintf(ParFile, "TIME_EXTENSION = %0.2f\n", Extension);
+            if (Stagnation > 0)
+                fprintf(ParFile, "STAGNATION_TIME = %0.2f\n",
+                        Stagnation * TimeLimit < 1 ? 1 :
+                        Stagnation * TimeLimit);
+            fprintf(ParFile, "CHECKPOINT_INTERVAL = 1\n");
+            fprintf(ParFile, "TRACE_LEVEL = 0\n");
+            fprintf(ParFile, "TOUR_FILE = %s/%s.tour\n",
+                    TourDirectory, I->Name);
+            fclose(ParFile);
+            if ((Pid = fork()) < 0) {
+                perror("fork");
+                return EXIT_FAILURE;
+            }
+            if (Pid == 0) {
+                execl("./LKH", "./LKH", ParFileName, (char *) 0);
+                perror("./LKH");
+                _exit(EXIT_FAILURE);
+            }
+            I->Pid = Pid;
+            I->ParFileName = strdup(ParFileName);
+            I->StartTime = Now;
+            I->TimeLimit = TimeLimit;
+            I->Extension = Extension > 0 ? Extension : 0;
+            WeightLeft -= I->Dimension;
+            Started++;
+            Running++;
+        }
+        while ((Pid = waitpid(-1, &Status, WNOHANG)) > 0) {
+            for (i = 0; i < Started && Set[i].Pid != Pid; i++);
+            if (i < Started) {
+                Set[i].Pid = 0;
+                unlink(Set[i].ParFileName);
+                Running--;
+                Finished++;
+            }
+        }
+        if (WallTime() >= Deadline) {
+            for (i = 0; i < Started; i++) {
+                if (Set[i].Pid > 0) {
+                    kill(Set[i].Pid, SIGKILL);
+                    waitpid(Set[i].Pid, &Status, 0);
+                    unlink(Set[i].ParFileName);
+                    fprintf(stderr, "%s: killed at deadline\n",
+                            Set[i].Name);
+                    Set[i].Pid = 0;
+                    Killed++;
+                }
+            }
+            if (Started < Count)
+                fprintf(stderr, "%d instances not started\n",
+                        Count - Started);
+            break;
+        }
+        usleep(10000);
+    }
+    for (i = 0; i < Count; i++) {
+        free(Set[i].Name);
+        free(Set[i].FileName);
+        free(Set[i].ParFileName);
+    }
+    free(Set);
+    free(TourDirectory);
+    return Killed > 0 || Started < Count ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+static double WallTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static int ReadDimension(char *FileName)
+{
+    FILE *In = fopen(FileName, "r");
+    char Line[256];
+    int Dimension = 1;
+
+    if (!In)
+        return Dimension;
+    while (fgets(Line, sizeof(Line), In)) {
+        if (!strncmp(Line, "DIMENSION", 9)) {
+            char *p = Line + 9;
+            while (*p == ' ' || *p == ':' || *p == '\t')
+                p++;
+            sscanf(p, "%d", &Dimension);
+            break;
+        }
+        if (strstr(Line, "_SECTION"))
+            break;
+    }
+    fclose(In);
+    return Dimension;
+}
+
+static int ByDimension(const void *a, const void *b)
+{
+    return ((Instance *) b)->Dimension - ((Instance *) a)->Dimension;
+}